@@ -1342,6 +1342,144 @@ def isolate_grad(when=True):
     return detail.ADContextManager(detail.ADScope.Isolate, [])
 
 
+class _CheckpointOp(CustomOp):
+    """
+    Custom operation implementing :py:func:`drjit.checkpoint`. It only retains
+    the (detached) inputs and re-executes the function when derivatives are
+    propagated through it.
+    """
+
+    def eval(self, func, args, kwargs):
+        self.func, self.args, self.kwargs = func, args, kwargs
+
+        with suspend_grad():
+            return func(*args, **kwargs)
+
+    def rematerialize(self):
+        # Re-run the function, tracking derivatives only w.r.t. its inputs
+        args, kwargs = detail.new_grad((self.args, self.kwargs))
+
+        with suspend_grad():
+            with resume_grad(args, kwargs):
+                output = self.func(*args, **kwargs)
+
+        return args, kwargs, output
+
+    def forward(self):
+        args, kwargs, output = self.rematerialize()
+        set_grad(args, self.grad_in('args'))
+        set_grad(kwargs, self.grad_in('kwargs'))
+        enqueue(ADMode.Forward, args, kwargs)
+        traverse(ADMode.Forward)
+        self.set_grad_out(grad(output))
+
+    def backward(self):
+        args, kwargs, output = self.rematerialize()
+        set_grad(output, self.grad_out())
+        enqueue(ADMode.Backward, output)
+        traverse(ADMode.Backward)
+        self.set_grad_in('args', grad(args))
+        self.set_grad_in('kwargs', grad(kwargs))
+
+    def name(self):
+        return "checkpoint"
+
+
+def checkpoint(func, *args, **kwargs):
+    """
+    Evaluate a function without recording its interior on the AD graph, and
+    recompute it when derivatives are later propagated through it.
+
+    Reverse-mode differentiation normally keeps all intermediate values
+    referenced by the AD graph (e.g., the edge weights of multiplications)
+    alive until the backward pass reaches them. For long computations, this
+    memory can exceed what the device can provide. The expression
+
+    .. code-block:: python
+
+       y = dr.checkpoint(f, x, z=z)
+
+    is mathematically equivalent to ``y = f(x, z=z)``. However, it only records
+    the inputs and outputs of ``f`` on the AD graph. When a forward or
+    backward AD traversal reaches the output ``y``, Dr.Jit runs ``f`` a second
+    time with derivative tracking enabled, propagates derivatives through
+    this temporary graph, and then discards it again.
+
+    Derivatives are only tracked with respect to the positional and keyword
+    arguments of the function. Differentiable variables that ``f`` accesses
+    in other ways (e.g., through a closure) are treated as constants. The
+    function should be deterministic, since it is evaluated twice.
+
+    Args:
+        func (Callable): The function to be evaluated.
+
+        *args (tuple): Positional arguments (arbitrary :ref:`PyTrees
+          <pytrees>`) to be forwarded to ``func``.
+
+        **kwargs (dict): Keyword arguments (arbitrary :ref:`PyTrees
+          <pytrees>`) to be forwarded to ``func``.
+
+    Returns:
+        object: The return value of ``func``.
+    """
+    return custom(_CheckpointOp, func, args, kwargs)
+
+
+def jacobian(f, x):
+    """
+    Compute the Jacobian of a function with respect to the entries of an array.
+
+    Given a one-dimensional differentiable array ``x`` with ``n`` entries
+    (e.g., a set of scene parameters), this function evaluates ``y = f(x)``
+    and returns a list with ``n`` elements. The ``k``-th element holds the
+    derivative of ``y`` with respect to ``x[k]``, which is a :ref:`PyTree
+    <pytrees>` with the same structure as ``y``.
+
+    The function evaluates ``f`` only once and then propagates one forward-mode
+    derivative per entry of ``x`` through the resulting AD graph, which is
+    retained until all columns are known. The Jacobian columns are finally
+    evaluated together, which produces a single kernel instead of one per
+    column. Forward mode is the right choice when ``x`` has few entries
+    compared to the output (e.g., for a sensitivity analysis with tens of
+    parameters).
+
+    Differentiable variables that ``f`` accesses in other ways (e.g., through
+    a closure) are treated as constants.
+
+    Args:
+        f (Callable): The function to be differentiated.
+
+        x (drjit.ArrayBase): A one-dimensional differentiable Dr.Jit array.
+
+    Returns:
+        list: The columns of the Jacobian.
+    """
+    if not is_diff_v(x) or depth_v(x) != 1:
+        raise TypeError("jacobian(): 'x' must be a one-dimensional "
+                        "differentiable Dr.Jit array!")
+
+    x = type(x)(detach(x))
+    n = width(x)
+    enable_grad(x)
+
+    index = arange(type(x), n)
+    result = []
+
+    with suspend_grad():
+        with resume_grad(x):
+            y = f(x)
+
+            for k in range(n):
+                set_grad(x, select(index == k, 1, 0))
+                enqueue(ADMode.Forward, x)
+                traverse(ADMode.Forward, flags=ADFlag.ClearVertices)
+                result.append(grad(y))
+                clear_grad(y)
+
+    eval(result)
+    return result
+
+
 # -------------------------------------------------------------------
 #      Miscellaneous
 # -------------------------------------------------------------------
@@ -1683,6 +1821,73 @@ def sh_eval(d: ArrayBase, order: int) -> list:
     return r
 
 
+def mlp_eval(x, weights, biases=None, activation='relu', output_activation=None):
+    """
+    Evaluate a small multilayer perceptron (MLP) separately on each lane.
+
+    The input ``x`` is a sequence of Jit arrays (e.g., a list of
+    :py:class:`drjit.cuda.Float` instances or a :py:class:`drjit.cuda.Array3f`)
+    that specifies the input vector of every lane. The function evaluates the
+    network layer by layer, where layer ``i`` computes
+
+    .. code-block:: python
+
+       x = activation(weights[i] @ x + biases[i])
+
+    and returns the outputs of the last layer as a list of arrays. The
+    activation function is applied following every layer except for the last
+    one, which uses ``output_activation`` instead.
+
+    The weights and biases must be tensors. There are two ways of specifying
+    them:
+
+    - ``weights`` may be a sequence of 2D tensors of shape ``(n_out, n_in)``,
+      and ``biases`` a sequence of 1D tensors of shape ``(n_out,)``.
+
+    - ``weights`` may be a single 3D tensor of shape ``(layers, n, n)``, and
+      ``biases`` a 2D tensor of shape ``(layers, n)``. This is convenient when
+      all layers have the same width.
+
+    This function is a convenience wrapper around existing operations rather
+    than a dedicated primitive. It unrolls all layers into a sequence of
+    :py:func:`drjit.gather` and :py:func:`drjit.fma` operations, which
+    subsequently fuse into the surrounding kernel like any other arithmetic.
+    Every lane gathers each weight separately from the same memory location.
+    The weights are *not* placed into a shared or constant buffer that is
+    loaded once per packet/warp. The function can be called within symbolic
+    loops and vectorized calls. Note that the size of the generated code is
+    proportional to the number of weights, which makes this function best
+    suited for small networks (e.g., 4 layers with 64 neurons).
+
+    The operation supports forward- and reverse-mode differentiation with
+    respect to ``x``, ``weights``, and ``biases``. The reverse-mode derivative
+    accumulates the per-lane weight gradients using a scatter-reduction with
+    :py:attr:`drjit.ReduceMode.Local`, which pre-reduces them within
+    packets/warps before issuing atomic memory operations.
+
+    Args:
+        x (Sequence[drjit.ArrayBase]): The per-lane input vector.
+
+        weights (drjit.ArrayBase | Sequence[drjit.ArrayBase]): The weight
+          matrices of all layers, see above.
+
+        biases (drjit.ArrayBase | Sequence[drjit.ArrayBase] | None): The bias
+          vectors of all layers, see above. The default (``None``) omits them.
+
+        activation (str | None): The activation function of hidden layers.
+          Must be one of ``"relu"`` (the default), ``"leaky_relu"``,
+          ``"tanh"``, ``"sigmoid"``, ``"sin"``, ``"none"``, or ``None``.
+
+        output_activation (str | None): The activation function of the last
+          layer. The default (``None``) produces a linear output.
+
+    Returns:
+        list[drjit.ArrayBase]: The per-lane output vector.
+    """
+    from . import _mlp as _mlp
+    return _mlp.mlp_eval(x, weights, biases, activation, output_activation)
+
+
 def meshgrid(*args, indexing='xy') -> tuple: # <- proper type signature in stubs
     '''
     Return flattened N-D coordinate arrays from a sequence of 1D coordinate vectors.
@@ -0,0 +1,347 @@
+import drjit as dr
+import math
+from typing import List, Tuple, TypeVar
+
+ArrayT = TypeVar("ArrayT", bound=dr.ArrayBase)
+
+# Size of the output tile computed by each thread of the register-tiled kernel
+_TILE_M, _TILE_N = 4, 4
+
+# Contractions up to this length are unrolled into straight-line code
+_UNROLL_K = 16
+
+# Minimum contraction length, from which the tiled kernel is preferred
+_TILED_K = 16
+
+
+def _compute_strides(shape: Tuple[int, ...]) -> Tuple[int, ...]:
+    """Turn a shape tuple into a C-style strides tuple"""
+    val, ndim = 1, len(shape)
+    strides = [0] * ndim
+    for i in reversed(range(ndim)):
+        strides[i] = val
+        val *= shape[i]
+    return tuple(strides)
+
+
+class _Operand:
+    """
+    Describes how to access a (potentially transposed) stack of matrices stored
+    in a flat array. ``shape`` holds the batch dimensions followed by the
+    number of rows and columns of the *stored* matrices.
+    """
+    def __init__(self, array, shape: Tuple[int, ...], transpose: bool = False):
+        self.array = array
+        self.batch = shape[:-2]
+        strides = _compute_strides(shape)
+        self.batch_strides = strides[:-2]
+        rows, cols = shape[-2:]
+        if transpose:
+            self.rows, self.cols = cols, rows
+            self.row_stride, self.col_stride = 1, cols
+        else:
+            self.rows, self.cols = rows, cols
+            self.row_stride, self.col_stride = cols, 1
+
+    def offset(self, batch: Tuple[int, ...], index: dr.AnyArray):
+        """
+        Compute the offset of the matrices with the given batch index. The
+        operand is broadcast along missing or 1-sized batch dimensions.
+        """
+        UInt32 = type(index)
+        offset = dr.zeros(UInt32, 1)
+        shift = len(batch) - len(self.batch)
+
+        for i in reversed(range(len(batch))):
+            size = batch[i]
+            pos = index % size if i > 0 else index
+            index = index // size
+
+            j = i - shift
+            if j >= 0 and self.batch[j] != 1:
+                offset = dr.fma(pos, self.batch_strides[j], offset)
+
+        return offset
+
+
+def _broadcast_batch(a: Tuple[int, ...], b: Tuple[int, ...]) -> Tuple[int, ...]:
+    """Broadcast two tuples of batch dimensions following NumPy's rules"""
+    ndim = max(len(a), len(b))
+    a = (1,) * (ndim - len(a)) + a
+    b = (1,) * (ndim - len(b)) + b
+    result = []
+    for i in range(ndim):
+        if a[i] != b[i] and a[i] != 1 and b[i] != 1:
+            raise RuntimeError(
+                "tensor_matmul(): incompatible batch dimensions "
+                f"{a} and {b}."
+            )
+        result.append(max(a[i], b[i]))
+    return tuple(result)
+
+
+def _matmul_fused(Value, a: _Operand, b: _Operand, batch: Tuple[int, ...]):
+    """
+    Compute every entry of the output in a separate thread. The result is an
+    ordinary (unevaluated) variable that fuses with subsequent computation.
+    """
+    UInt32 = dr.uint32_array_t(Value)
+    m, n, k = a.rows, b.cols, a.cols
+
+    size = math.prod(batch) * m * n
+    index = dr.arange(UInt32, size)
+    col = index % n
+    index = index // n
+    row = index % m
+    index = index // m
+
+    offset_a = a.offset(batch, index) + row * a.row_stride
+    offset_b = b.offset(batch, index) + col * b.col_stride
+
+    def step(i, accum):
+        return dr.fma(
+            dr.gather(Value, a.array, offset_a + i * a.col_stride),
+            dr.gather(Value, b.array, offset_b + i * b.row_stride),
+            accum
+        )
+
+    accum = dr.zeros(Value, size)
+
+    if k <= _UNROLL_K or not dr.is_jit_v(Value):
+        for i in range(k):
+            accum = step(i, accum)
+        return accum
+
+    return dr.while_loop(
+        label="matmul",
+        labels=("i", "accum"),
+        state=(UInt32(0), accum),
+        cond=lambda i, accum: i < k,
+        body=lambda i, accum: (i + 1, step(i, accum)),
+        unroll=4
+    )[1]
+
+
+def _matmul_tiled(Value, a: _Operand, b: _Operand, batch: Tuple[int, ...]):
+    """
+    Register-tiled kernel: every thread computes a block of ``_TILE_M x
+    _TILE_N`` output entries. This reduces the number of gathers per
+    multiply-accumulate operation from 2 to ``1/_TILE_M + 1/_TILE_N``.
+    The tiles are scattered into an output buffer.
+    """
+    UInt32 = dr.uint32_array_t(Value)
+    m, n, k = a.rows, b.cols, a.cols
+    tiles_m = (m + _TILE_M - 1) // _TILE_M
+    tiles_n = (n + _TILE_N - 1) // _TILE_N
+
+    size = math.prod(batch) * tiles_m * tiles_n
+    index = dr.arange(UInt32, size)
+    tile_n = index % tiles_n
+    index = index // tiles_n
+    tile_m = index % tiles_m
+    index = index // tiles_m
+
+    offset_a = a.offset(batch, index)
+    offset_b = b.offset(batch, index)
+    offset_out = index * (m * n)
+
+    rows, cols = [], []
+    row_active: List[object] = []
+    col_active: List[object] = []
+
+    for r in range(_TILE_M):
+        row = tile_m * _TILE_M + r
+        rows.append(row)
+        row_active.append(row < m if m % _TILE_M else True)
+
+    for c in range(_TILE_N):
+        col = tile_n * _TILE_N + c
+        cols.append(col)
+        col_active.append(col < n if n % _TILE_N else True)
+
+    rows_a = [offset_a + row * a.row_stride for row in rows]
+    cols_b = [offset_b + col * b.col_stride for col in cols]
+
+    def body(i, accum):
+        va = [dr.gather(Value, a.array, rows_a[r] + i * a.col_stride,
+                        row_active[r]) for r in range(_TILE_M)]
+        vb = [dr.gather(Value, b.array, cols_b[c] + i * b.row_stride,
+                        col_active[c]) for c in range(_TILE_N)]
+        accum = [dr.fma(va[r], vb[c], accum[r * _TILE_N + c])
+                 for r in range(_TILE_M) for c in range(_TILE_N)]
+        return i + 1, accum
+
+    accum = [dr.zeros(Value, size) for _ in range(_TILE_M * _TILE_N)]
+
+    accum = dr.while_loop(
+        label="matmul_tiled",
+        labels=("i", "accum"),
+        state=(UInt32(0), accum),
+        cond=lambda i, accum: i < k,
+        body=body
+    )[1]
+
+    result = dr.zeros(Value, math.prod(batch) * m * n)
+    for r in range(_TILE_M):
+        for c in range(_TILE_N):
+            dr.scatter(
+                result,
+                accum[r * _TILE_N + c],
+                offset_out + rows[r] * n + cols[c],
+                row_active[r] & col_active[c]
+            )
+
+    return result
+
+
+def _matmul(Value, a: _Operand, b: _Operand):
+    """Multiply two stacks of matrices and return a flat array and its shape"""
+    if a.cols != b.rows:
+        raise RuntimeError(
+            "tensor_matmul(): incompatible matrix dimensions "
+            f"({a.rows}, {a.cols}) and ({b.rows}, {b.cols})."
+        )
+
+    batch = _broadcast_batch(a.batch, b.batch)
+    shape = batch + (a.rows, b.cols)
+
+    if a.cols == 0 or math.prod(shape) == 0:
+        return dr.zeros(Value, math.prod(shape)), shape
+
+    use_tiled = dr.backend_v(Value) is dr.JitBackend.LLVM and \
+        a.rows >= _TILE_M and b.cols >= _TILE_N and a.cols >= _TILED_K
+
+    if use_tiled:
+        result = _matmul_tiled(Value, a, b, batch)
+    else:
+        result = _matmul_fused(Value, a, b, batch)
+
+    return result, shape
+
+
+def _reduce_batch(Tensor, array, shape: Tuple[int, ...], target: Tuple[int, ...]):
+    """
+    Sum the gradient ``array`` of shape ``shape`` over the batch dimensions
+    that the operand with the (normalized) shape ``target`` was broadcast along
+    """
+    shift = len(shape) - len(target)
+    axis = tuple(i for i in range(len(shape) - 2)
+                 if i < shift or (target[i - shift] == 1 and shape[i] != 1))
+    if axis:
+        array = dr.sum(Tensor(array, shape), axis=axis).array
+    return array
+
+
+class _MatmulOp(dr.CustomOp):
+    """Custom operation that differentiates :py:func:`tensor_matmul`"""
+
+    def eval(self, a, b):
+        self.a, self.b = a, b
+        self.shape_a, self.shape_b = _normalize(a, b)
+        Value = dr.array_t(a)
+        result, self.shape = _matmul(Value,
+                                     _Operand(a.array, self.shape_a),
+                                     _Operand(b.array, self.shape_b))
+        return type(a)(result, _output_shape(a, b, self.shape))
+
+    def forward(self):
+        Tensor, Value = type(self.a), dr.array_t(self.a)
+        grad_a, grad_b = self.grad_in('a'), self.grad_in('b')
+
+        result, _ = _matmul(Value, _Operand(grad_a.array, self.shape_a),
+                            _Operand(self.b.array, self.shape_b))
+        result2, _ = _matmul(Value, _Operand(self.a.array, self.shape_a),
+                             _Operand(grad_b.array, self.shape_b))
+
+        shape = _output_shape(self.a, self.b, self.shape)
+        self.set_grad_out(Tensor(result + result2, shape))
+
+    def backward(self):
+        Tensor, Value = type(self.a), dr.array_t(self.a)
+        grad = self.grad_out().array
+        shape_a, shape_b = self.shape_a, self.shape_b
+
+        # grad_a = grad @ b^T, grad_b = a^T @ grad
+        grad_a, shape = _matmul(Value, _Operand(grad, self.shape),
+                                _Operand(self.b.array, shape_b, True))
+        grad_a = _reduce_batch(Tensor, grad_a, shape, shape_a)
+
+        grad_b, shape = _matmul(Value, _Operand(self.a.array, shape_a, True),
+                                _Operand(grad, self.shape))
+        grad_b = _reduce_batch(Tensor, grad_b, shape, shape_b)
+
+        self.set_grad_in('a', Tensor(grad_a, self.a.shape))
+        self.set_grad_in('b', Tensor(grad_b, self.b.shape))
+
+    def name(self):
+        return "matmul"
+
+
+def _normalize(a, b) -> Tuple[Tuple[int, ...], Tuple[int, ...]]:
+    """
+    Following NumPy, turn 1D operands into a row (``a``) or column (``b``)
+    vector and return the shapes of both operands
+    """
+    shape_a, shape_b = a.shape, b.shape
+    if len(shape_a) == 0 or len(shape_b) == 0:
+        raise RuntimeError(
+            "tensor_matmul(): operands must have at least one dimension. "
+            "Use the '*' operator to multiply by a scalar."
+        )
+    if len(shape_a) == 1:
+        shape_a = (1,) + shape_a
+    if len(shape_b) == 1:
+        shape_b = shape_b + (1,)
+    return shape_a, shape_b
+
+
+def _output_shape(a, b, shape: Tuple[int, ...]) -> Tuple[int, ...]:
+    """Remove the dimensions that :py:func:`_normalize` added"""
+    if len(a.shape) == 1:
+        shape = shape[:-2] + shape[-1:]
+    if len(b.shape) == 1:
+        shape = shape[:-1]
+    return shape
+
+
+def tensor_matmul(a: ArrayT, b: ArrayT) -> ArrayT:
+    """
+    This function computes the matrix product of the tensors ``a`` and ``b``.
+    It is an implementation detail of the top-level function
+    ``drjit.matmul()`` used to handle tensor arguments.
+
+    The operation follows the semantics of ``numpy.matmul()``: the last two
+    dimensions of each tensor hold a matrix, and any leading dimensions are
+    batch dimensions that are broadcast against each other. 1D operands are
+    interpreted as row or column vectors.
+
+    The function supports two evaluation strategies:
+
+    1. By default, each thread computes one entry of the output. This
+       produces an ordinary unevaluated tensor that fuses with subsequent
+       computation. The contraction is unrolled when it is short, and
+       otherwise runs in a symbolic loop.
+
+    2. On the LLVM backend, sufficiently large products instead use a
+       register-tiled kernel, where each thread computes a 4x4 block of the
+       output. This reduces the number of memory accesses by a factor of 4,
+       but the output must be scattered into a buffer.
+
+    Derivatives are propagated using a custom operation that evaluates
+    further matrix products: ``grad_a = grad @ b^T`` and ``grad_b = a^T @
+    grad`` in reverse mode.
+    """
+    Tensor = type(a)
+
+    if Tensor is not type(b) or not dr.is_tensor_v(b):
+        raise RuntimeError(
+            "tensor_matmul(): both operands must be tensors of the same type."
+        )
+
+    if dr.grad_enabled(a) or dr.grad_enabled(b):
+        return dr.custom(_MatmulOp, a, b)
+
+    shape_a, shape_b = _normalize(a, b)
+    result, shape = _matmul(dr.array_t(a), _Operand(a.array, shape_a),
+                            _Operand(b.array, shape_b))
+    return Tensor(result, _output_shape(a, b, shape))
@@ -0,0 +1,124 @@
+import drjit as dr
+import math
+from typing import Callable, Dict, List, Optional, Sequence, Tuple
+
+_activations: Dict[str, Callable] = {
+    'relu': lambda x: dr.maximum(x, 0),
+    'leaky_relu': lambda x: dr.select(x > 0, x, x * 0.01),
+    'tanh': lambda x: dr.tanh(x),
+    'sigmoid': lambda x: dr.rcp(1 + dr.exp(-x)),
+    'sin': lambda x: dr.sin(x),
+    'none': lambda x: x,
+}
+
+
+def _activation(name: Optional[str]) -> Callable:
+    if name is None:
+        name = 'none'
+    act = _activations.get(name, None)
+    if act is None:
+        raise RuntimeError(
+            f'mlp_eval(): unsupported activation function "{name}" (must '
+            f'be one of {", ".join(_activations.keys())}, or None).'
+        )
+    return act
+
+
+def _split_layers(weights, name: str, ndim: int) -> List[Tuple[object, int, Tuple[int, ...]]]:
+    """
+    Turn a sequence of tensors, or a single tensor with a leading layer
+    dimension into a list of ``(array, offset, shape)`` triplets
+    """
+    if dr.is_tensor_v(weights):
+        shape = weights.shape
+        if len(shape) != ndim + 1:
+            raise RuntimeError(
+                f'mlp_eval(): the "{name}" tensor must have {ndim + 1} '
+                'dimensions, where the first one indexes the layer.'
+            )
+        size = math.prod(shape[1:])
+        return [(weights.array, i * size, shape[1:]) for i in range(shape[0])]
+
+    result = []
+    for w in weights:
+        if not dr.is_tensor_v(w) or len(w.shape) != ndim:
+            raise RuntimeError(
+                f'mlp_eval(): "{name}" must contain {ndim}D tensors.'
+            )
+        result.append((w.array, 0, w.shape))
+    return result
+
+
+def mlp_eval(
+    x: Sequence[dr.ArrayBase],
+    weights,
+    biases=None,
+    activation: Optional[str] = 'relu',
+    output_activation: Optional[str] = None
+) -> List[dr.ArrayBase]:
+    """
+    Implementation of :py:func:`drjit.mlp_eval`, see the documentation there.
+    This simply unrolls the network into gathers and FMAs.
+    """
+    x = list(x)
+    if len(x) == 0:
+        raise RuntimeError('mlp_eval(): the input must be nonempty.')
+
+    Float = type(x[0])
+    UInt32 = dr.uint32_array_t(Float)
+    act, act_out = _activation(activation), _activation(output_activation)
+
+    layers = _split_layers(weights, 'weights', 2)
+    bias_layers = _split_layers(biases, 'biases', 1) if biases is not None \
+        else [None] * len(layers)
+
+    if len(bias_layers) != len(layers):
+        raise RuntimeError(
+            'mlp_eval(): "weights" and "biases" specify a different number '
+            'of layers.'
+        )
+
+    # Every lane fetches the weights using a uniform, full-width index. A
+    # size-1 index would instead require a horizontal reduction of the
+    # gradient of each weight in the reverse pass, which is both slow and
+    # unsupported within symbolic operations. With a full-width index, the
+    # derivative is a scatter-reduction that is pre-reduced within
+    # packets/warps before issuing atomic memory operations.
+    mode = dr.ReduceMode.Local
+    width = max(dr.width(v) for v in x)
+
+    def fetch(array, index: int):
+        return dr.gather(Float, array, dr.full(UInt32, index, width), mode=mode)
+
+    for layer, ((w, w_offset, shape), bias) in enumerate(zip(layers, bias_layers)):
+        n_out, n_in = shape
+        if n_in != len(x):
+            raise RuntimeError(
+                f'mlp_eval(): layer {layer} expects {n_in} inputs, but the '
+                f'previous layer produced {len(x)} values.'
+            )
+
+        if bias is not None and bias[2] != (n_out,):
+            raise RuntimeError(
+                f'mlp_eval(): the bias of layer {layer} must have shape '
+                f'({n_out},).'
+            )
+
+        f = act_out if layer + 1 == len(layers) else act
+        y = []
+
+        for j in range(n_out):
+            if bias is not None:
+                accum = fetch(bias[0], bias[1] + j)
+            else:
+                accum = Float(0)
+
+            row = w_offset + j * n_in
+            for i in range(n_in):
+                accum = dr.fma(fetch(w, row + i), x[i], accum)
+
+            y.append(f(accum))
+
+        x = y
+
+    return x
@@ -28,8 +28,128 @@ else:
 T = TypeVar("T")
 T2 = TypeVar("T2")
 
+# Dr.Jit functions without side effects, whose calls may be hoisted out of loops
+_pure_funcs = frozenset((
+    "abs", "acos", "asin", "atan", "atan2", "cbrt", "ceil", "clip", "cos",
+    "cosh", "cross", "dot", "erf", "exp", "exp2", "floor", "fma", "lerp",
+    "log", "log2", "maximum", "minimum", "norm", "normalize", "power", "rcp",
+    "round", "rsqrt", "safe_acos", "safe_asin", "safe_sqrt", "select", "sign",
+    "sin", "sincos", "sinh", "sqr", "sqrt", "square", "squared_norm", "tan",
+    "tanh", "trunc"
+))
+
+# Names under which Dr.Jit is usually imported
+_drjit_aliases = frozenset(("dr", "drjit"))
+
+
+def _root_name(node: ast.AST) -> Optional[str]:
+    # Find the variable underlying an expression like 'a.b[c].d'
+    while isinstance(node, (ast.Attribute, ast.Subscript, ast.Starred)):
+        node = node.value
+    return node.id if isinstance(node, ast.Name) else None
+
+
+def _uses_variables(node: ast.AST) -> bool:
+    # Does an expression reference variables (ignoring called functions)?
+    if isinstance(node, ast.Name):
+        return True
+    elif isinstance(node, ast.Call):
+        return any(_uses_variables(n) for n in
+                   [*node.args, *(k.value for k in node.keywords)])
+    return any(_uses_variables(n) for n in ast.iter_child_nodes(node))
+
+
+def _is_pure_call(node: ast.Call) -> bool:
+    func = node.func
+    return (
+        isinstance(func, ast.Attribute)
+        and isinstance(func.value, ast.Name)
+        and func.value.id in _drjit_aliases
+        and func.attr in _pure_funcs
+    )
+
+
+# Statements whose nested code only runs conditionally (or repeatedly)
+_conditional_stmts = (
+    ast.If, ast.While, ast.For, ast.AsyncFor, ast.Try, ast.With, ast.AsyncWith,
+    *((ast.Match,) if hasattr(ast, "Match") else ()),
+    *((ast.TryStar,) if hasattr(ast, "TryStar") else ())
+)
+
+# Statements that can prevent the remainder of a loop body from running
+_jump_stmts = (ast.Break, ast.Continue, ast.Return, ast.Raise, ast.Assert)
+
+
+class _HoistTransformer(ast.NodeTransformer):
+    # Replaces maximal loop-invariant expressions by temporary variables. Only
+    # expressions that are evaluated unconditionally in each loop iteration
+    # are considered, since hoisting an expression out of a guarded region
+    # (e.g., 'if k != 0: y += n // k') could raise an exception or perform
+    # otherwise unwanted work when its operands are Python objects.
+    def __init__(self, variant, counter):
+        super().__init__()
+        self.variant = variant
+        self.counter = counter
+        self.names, self.exprs = {}, []
+
+    def invariant(self, node: ast.AST) -> bool:
+        if isinstance(node, ast.Constant):
+            return True
+        elif isinstance(node, ast.Name):
+            return node.id not in self.variant
+        elif isinstance(node, ast.BinOp):
+            return self.invariant(node.left) and self.invariant(node.right)
+        elif isinstance(node, ast.UnaryOp):
+            return self.invariant(node.operand)
+        elif isinstance(node, ast.Compare):
+            return self.invariant(node.left) and \
+                all(self.invariant(n) for n in node.comparators)
+        elif isinstance(node, ast.Call):
+            return _is_pure_call(node) and \
+                all(self.invariant(n) for n in node.args) and \
+                all(k.arg is not None and self.invariant(k.value)
+                    for k in node.keywords)
+        return False
+
+    def visit(self, node: ast.AST) -> ast.AST:
+        if (
+            isinstance(node, (ast.BinOp, ast.UnaryOp, ast.Compare, ast.Call))
+            and self.invariant(node)
+            and _uses_variables(node)
+        ):
+            key = ast.dump(node)
+            name = self.names.get(key, None)
+            if name is None:
+                name = f"_loop_inv{self.counter + len(self.exprs)}"
+                self.names[key] = name
+                self.exprs.append((name, node))
+            return ast.copy_location(ast.Name(id=name, ctx=ast.Load()), node)
+        elif isinstance(node, ast.If):
+            node.test = self.visit(node.test)
+            return node
+        elif isinstance(node, ast.IfExp):
+            node.test = self.visit(node.test)
+            return node
+        elif isinstance(node, ast.BoolOp):
+            node.values[0] = self.visit(node.values[0])
+            return node
+        elif isinstance(node, _conditional_stmts):
+            return node
+        return super().visit(node)
+
+    def visit_body(self, body: List[ast.stmt]) -> List[ast.stmt]:
+        # Transform a loop body up to the first statement that might skip the
+        # remaining ones (e.g., a 'break' within a scalar 'if' statement)
+        result = []
+        for i, n in enumerate(body):
+            result.append(self.visit(n))
+            if any(isinstance(n2, _jump_stmts) for n2 in ast.walk(n)):
+                return result + body[i + 1:]
+        return result
+
+
 class _SyntaxVisitor(ast.NodeTransformer):
-    def __init__(self, recursive, filename, line_offset):
+    def __init__(self, recursive, filename, line_offset, hoist=False):
         super().__init__()
 
         # Keep track of read/written variables
@@ -52,6 +172,10 @@ class _SyntaxVisitor(ast.NodeTransformer):
         self.filename = filename
         self.line_offset = line_offset
 
+        # Hoist loop-invariant expressions out of loops? (+ counter for names)
+        self.hoist = hoist
+        self.hoist_counter = 0
+
     def visit_FunctionDef(self, node: ast.FunctionDef) -> ast.AST:
         if self.recursive or self.depth == 0:
             # Process only the outermost function
@@ -208,6 +332,7 @@ class _SyntaxVisitor(ast.NodeTransformer):
             "max_iterations",
             "strict",
             "compress",
+            "unroll",
         ]
         for k2 in hints.keys():
             if k2 not in valid_keys:
@@ -459,7 +584,56 @@ class _SyntaxVisitor(ast.NodeTransformer):
             comment_end,
         ]
 
+    def hoist_invariants(self, node: ast.While) -> List[Tuple[str, ast.expr]]:
+        # Don't touch loops that will remain scalar Python loops
+        _, hints = self.extract_hints(node.test)
+        mode = hints.get("mode", None)
+        if isinstance(mode, ast.Constant) and mode.value == "scalar":
+            return []
+
+        # Determine the set of variables that may change within the loop
+        variant = set()
+        for n in ast.walk(node):
+            if isinstance(n, (ast.FunctionDef, ast.AsyncFunctionDef, ast.Lambda,
+                              ast.ClassDef, ast.Global, ast.Nonlocal,
+                              ast.Import, ast.ImportFrom, ast.ListComp,
+                              ast.SetComp, ast.DictComp, ast.GeneratorExp,
+                              ast.NamedExpr)):
+                # Scoping rules are too complex, don't hoist anything
+                return []
+            elif isinstance(n, (ast.Name, ast.Attribute, ast.Subscript)):
+                if not isinstance(n.ctx, ast.Load):
+                    variant.add(_root_name(n))
+            elif isinstance(n, ast.Call) and not _is_pure_call(n):
+                # Other functions could modify their arguments in-place
+                args = [*n.args, *(k.value for k in n.keywords)]
+                if isinstance(n.func, ast.Attribute):
+                    args.append(n.func.value)
+                for a in args:
+                    name = _root_name(a)
+                    if name not in _drjit_aliases:
+                        variant.add(name)
+
+        transformer = _HoistTransformer(variant, self.hoist_counter)
+        node.body = transformer.visit_body(node.body)
+        self.hoist_counter += len(transformer.exprs)
+
+        if transformer.exprs:
+            import drjit
+
+            lineno = node.lineno + self.line_offset
+            exprs = ", ".join(ast.unparse(e) for _, e in transformer.exprs)
+            drjit.detail.log(
+                drjit.LogLevel.Info,
+                f"@drjit.syntax ({self.filename}:{lineno}): hoisted "
+                f"{len(transformer.exprs)} loop-invariant expression(s) in "
+                f"front of the loop: {exprs}")
+
+        return transformer.exprs
+
     def visit_While(self, node: ast.While):
+        hoisted = self.hoist_invariants(node) if self.hoist else []
+
         (node, state, _, hints, is_scalar) = self.rewrite_and_track(node)
         if is_scalar:
             return node
@@ -570,12 +744,25 @@ class _SyntaxVisitor(ast.NodeTransformer):
             ast.Name(id=loop_name, ctx=delete),
             ast.Name(id=cond_name, ctx=delete),
             ast.Name(id=body_name, ctx=delete),
+            *(ast.Name(id=k, ctx=delete) for k, _ in hoisted)
         ]
 
         cleanup = ast.Delete(targets=cleanup_targets)
 
+        # 11. Evaluate loop-invariant expressions in front of the loop
+        prelude = [
+            ast.Assign(
+                targets=[ast.Name(id=k, ctx=store)],
+                value=v,
+                lineno=v.lineno,
+                col_offset=v.col_offset,
+            )
+            for k, v in hoisted
+        ]
+
         return [
             comment_start,
+            *prelude,
             cond_func,
             body_func,
             comment_mid,
@@ -591,7 +778,8 @@ _syntax_counter = 0
 
 @overload
 def syntax(
-    f: None = None, *, recursive: bool = False, print_ast: bool = False, print_code: bool = False
+    f: None = None, *, recursive: bool = False, print_ast: bool = False,
+    print_code: bool = False, hoist: bool = False
 ) -> Callable[[T], T]:
     """
     Syntax decorator for vectorized loops and conditionals.
@@ -758,6 +946,21 @@ def syntax(
     containing *nested* functions, it only transforms the outermost function by
     default. Specify the ``recursive=True`` parameter to process them as well.
 
+    Loops often compute expressions that don't change from one iteration to
+    the next (e.g., ``a * b`` where neither ``a`` nor ``b`` are modified by the
+    loop). Symbolic loops re-evaluate them in every iteration of the generated
+    kernel. Specify ``hoist=True`` to move such *loop-invariant* expressions
+    in front of the loop, where they are only evaluated once. The analysis is
+    conservative: it only considers arithmetic, comparisons, and calls to
+    side-effect-free Dr.Jit functions like :py:func:`drjit.sqrt` involving
+    variables that are never assigned, modified in-place, or passed to other
+    functions within the loop. Expressions in code that only runs conditionally
+    (e.g., within ``if`` statements, ``try`` blocks, nested loops, or after a
+    ``break`` or ``continue`` statement) are left in place. Hoisted
+    expressions are evaluated even when the loop doesn't run, and they are
+    reported via the log level
+    :py:attr:`drjit.LogLevel.Info` when the function is transformed.
+
     One last point: :py:func:`@dr.syntax <drjit.syntax>` may seem
     reminiscent of function--level transformations in other frameworks like
     ``@jax.jit`` (JAX) or ``@tf.function`` (TensorFlow). There is a key
@@ -772,7 +975,8 @@ def syntax(
 
 @overload
 def syntax(
-    f: T, *, recursive: bool = False, print_ast: bool = False, print_code: bool = False
+    f: T, *, recursive: bool = False, print_ast: bool = False,
+    print_code: bool = False, hoist: bool = False
 ) -> T:
     ...
 
@@ -783,6 +987,7 @@ def syntax(
     recursive: bool = False,
     print_ast: bool = False,
     print_code: bool = False,
+    hoist: bool = False,
 ) -> Union[T, Callable[[T2], T2]]:
     global _syntax_counter
 
@@ -790,7 +995,8 @@ def syntax(
 
         def wrapper(f2: T2) -> T2:
             return syntax(
-                f2, recursive=recursive, print_ast=print_ast, print_code=print_code
+                f2, recursive=recursive, print_ast=print_ast,
+                print_code=print_code, hoist=hoist
             )
 
         return wrapper
@@ -834,7 +1040,7 @@ def syntax(
     if print_code:
         print(f"Input code\n----------\n{ast.unparse(old_ast)}\n")
 
-    new_ast = _SyntaxVisitor(recursive, filename, line_offset).visit(old_ast)
+    new_ast = _SyntaxVisitor(recursive, filename, line_offset, hoist).visit(old_ast)
     new_ast = ast.fix_missing_locations(new_ast)
 
     if print_ast:
@@ -860,8 +1066,9 @@ def hint(
     arg: T,
     /,
     *,
-    mode: Literal["scalar", "evaluated", "symbolic", None] = None,
+    mode: Literal["scalar", "evaluated", "symbolic", "hybrid", None] = None,
     max_iterations: Optional[int] = None,
+    unroll: Union[int, Literal["full"], None] = None,
     label: Optional[str] = None,
     include: Optional[List[object]] = None,
     exclude: Optional[List[object]] = None,
@@ -920,6 +1127,11 @@ def hint(
          :py:attr:`drjit.JitFlag.SymbolicLoops`, :py:func:`drjit.if_stmt`, and
          :py:attr:`drjit.JitFlag.SymbolicConditionals` for details.
 
+       - ``mode='hybrid'`` is only supported by ``while`` loops. It forwards
+         this argument to :py:func:`drjit.while_loop`, which then executes
+         chunks of several iterations per kernel (see
+         :py:func:`drjit.set_loop_hybrid_chunk_size`).
+
     2. The optional ``strict=False`` reduces the strictness of variable
        consistency checks.
 
@@ -969,13 +1181,28 @@ def hint(
        hint. Otherwise, reverse-mode differentiation of loops will fail with an
        error message.
 
-    4. ``label`` provovides a descriptive label.
+    4. ``unroll`` unrolls a ``while`` loop while tracing it. An integer ``k >
+       1`` traces ``k`` iterations per copy of the loop body, and
+       ``unroll='full'`` turns a loop with a trip count that is known at
+       tracing time into straight-line code.
+
+       .. code-block:: python
+
+          i = UInt32(0)
+          while dr.hint(i < 4, unroll='full'):
+             # ...
+             i += 1
+
+       The hint is forwarded to :py:func:`drjit.while_loop`, whose
+       documentation explains the details.
+
+    5. ``label`` provovides a descriptive label.
 
        Dr.Jit will include this label as a comment in the generated
        intermediate representation, which can be helpful when debugging the
        compilation of large programs.
 
-    5. ``include`` and ``exclude`` indicates to the :py:func:`@drjit.syntax
+    6. ``include`` and ``exclude`` indicates to the :py:func:`@drjit.syntax
        <drjit.syntax>` decorator that a local variable *should* or *should not*
        be considered to be part of the set of state variables passed to
        :py:func:`drjit.while_loop` or :py:func:`drjit.if_stmt`.
@@ -772,6 +772,34 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBaseT :
         return zeros<Value>();
     }
 
+    template <typename Mask, enable_if_t<Mask::Depth == 1> = 0>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        size_t sa = derived().size(), sb = mask.size(),
+               sr = sa > sb ? sa : sb, k = 0;
+
+        Value *out = (Value *) ptr;
+        for (size_t i = 0; i < sr; ++i) {
+            if (mask.entry(i))
+                out[k++] = derived().entry(i);
+        }
+
+        return k;
+    }
+
+    template <typename Mask, enable_if_t<Mask::Depth == 1> = 0>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        size_t size = mask.size(), k = 0;
+        Derived result = zeros<Derived>(size);
+
+        const Value *in = (const Value *) ptr;
+        for (size_t i = 0; i < size; ++i) {
+            if (mask.entry(i))
+                result.set_entry(i, in[k++]);
+        }
+
+        return result;
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 
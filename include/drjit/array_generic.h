@@ -41,6 +41,15 @@ namespace detail {
                                          (is_integral_ext_v<Type> &&
                                           (sizeof(Type) == 4 || sizeof(Type) == 8));
 
+    /**
+     * Half precision packets are only provided for specific sizes (see
+     * 'packet_avx.h', 'packet_avx512.h', and 'packet_neon.h'), which
+     * specialize this template
+     */
+    template <typename Type, size_t Size> struct vectorize_half {
+        static constexpr bool self = false;
+    };
+
     template <typename Type, size_t Size>
     using vectorize_t = vectorize<Type, Size * sizeof(Type)>;
 
@@ -49,7 +58,8 @@ namespace detail {
         enable_if_t<Size != 0 &&
                     !(vectorizable_type_v<Type> &&
                       (vectorize_t<Type, Size>::self ||
-                       (Size >= 4 && vectorize_t<Type, Size>::recurse)))>;
+                       (Size >= 4 && vectorize_t<Type, Size>::recurse))) &&
+                    !vectorize_half<Type, Size>::self>;
 
     template <typename Type, size_t Size>
     using enable_if_recursive =
@@ -111,7 +111,7 @@ struct MaskBase : StaticArrayImpl<Value_, Size_, true, Derived_> {
         if constexpr (Base::IsKMask) {
             return Base::bit_(index);
         } else if constexpr (Base::IsPacked) {
-            using Int = int_array_t<Value_>;
+            using Int = int_array_t<Scalar>;
             return memcpy_cast<Int>(Base::entry(index)) != 0;
         } else {
             return Base::entry(index);
@@ -122,8 +122,8 @@ struct MaskBase : StaticArrayImpl<Value_, Size_, true, Derived_> {
         if constexpr (Base::IsKMask) {
             Base::set_bit_(index, value);
         } else if constexpr (Base::IsPacked) {
-            using Int = int_array_t<Value_>;
-            Base::entry(index) = memcpy_cast<Value_>(Int(value ? -1 : 0));
+            using Int = int_array_t<Scalar>;
+            Base::entry(index) = memcpy_cast<Scalar>(Int(value ? -1 : 0));
         } else {
             Base::entry(index) = value;
         }
@@ -627,6 +627,39 @@ uint32_array_t<array_t<Mask>> compress(const Mask &mask) {
     return mask.compress_();
 }
 
+/**
+ * \brief Store the active entries of \c value contiguously to \c ptr
+ *
+ * Writes the entries of \c value whose \c mask bit is set (in order) to
+ * consecutive memory locations starting at \c ptr and returns their number.
+ * Memory beyond the last stored entry is not touched.
+ */
+template <typename Array, typename Mask>
+DRJIT_INLINE size_t compress_store(void *ptr, const Array &value, const Mask &mask) {
+    if constexpr (is_array_v<Array>) {
+        return value.compress_store_(ptr, mask);
+    } else {
+        if ((bool) mask)
+            *static_cast<Array *>(ptr) = value;
+        return (bool) mask ? 1 : 0;
+    }
+}
+
+/**
+ * \brief Load consecutive entries from \c ptr into the active lanes
+ *
+ * This is the inverse of \ref compress_store(): the i-th active lane (in
+ * order) receives <tt>ptr[i]</tt>, and inactive lanes are set to zero. Only
+ * <tt>count(mask)</tt> entries are read.
+ */
+template <typename Array, typename Mask>
+DRJIT_INLINE Array expand_load(const void *ptr, const Mask &mask) {
+    if constexpr (is_array_v<Array>)
+        return Array::expand_load_(ptr, mask);
+    else
+        return (bool) mask ? *static_cast<const Array *>(ptr) : Array(0);
+}
+
 //! @}
 // -----------------------------------------------------------------------
 
@@ -926,6 +959,35 @@ template <typename T> DRJIT_INLINE void store(void *ptr, const T &value) {
         *static_cast<T *>(ptr) = value;
 }
 
+/**
+ * \brief Load a nested array from unaligned memory in array-of-structures
+ * (AoS) layout
+ *
+ * \c T must be a static array of packets, e.g. <tt>Array<Packet<float, 8>,
+ * 3></tt>. The function reads <tt>size_v<value_t<T>></tt> consecutive records
+ * of <tt>size_v<T></tt> scalars each (e.g. interleaved xyz positions) and
+ * returns them in structure-of-arrays layout: entry \c j of the result holds
+ * field \c j of every record.
+ */
+template <typename T> DRJIT_INLINE T load_aos(const void *ptr) {
+    using Packet = value_t<T>;
+    static_assert(depth_v<T> == 2 && !is_dynamic_v<T> && !is_jit_v<T>,
+                  "load_aos(): expected a static array of packets!");
+
+    T result;
+    Packet::template load_aos_<T::Size>(ptr, result.data());
+    return result;
+}
+
+/// Store a nested array to unaligned memory in array-of-structures layout (see \ref load_aos())
+template <typename T> DRJIT_INLINE void store_aos(void *ptr, const T &value) {
+    using Packet = value_t<T>;
+    static_assert(depth_v<T> == 2 && !is_dynamic_v<T> && !is_jit_v<T>,
+                  "store_aos(): expected a static array of packets!");
+
+    Packet::template store_aos_<T::Size>(ptr, value.data());
+}
+
 template <typename Target, typename Source, typename Index, typename Mask = mask_t<Index>>
 Target gather(Source &&source, const Index &index, const Mask &mask_ = true,
               ReduceMode mode = ReduceMode::Auto) {
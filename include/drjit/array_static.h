@@ -159,6 +159,38 @@ struct StaticArrayBase : ArrayBaseT<Value_, IsMask_, Derived_> {
         }
     }
 
+    /// Load 'N' packets from interleaved records (see \ref load_aos())
+    template <size_t N>
+    static void load_aos_(const void *mem, Derived *out) {
+        static_assert(drjit::detail::is_scalar_v<Value>,
+                      "load_aos(): expected an array of packets!");
+
+        const Value *in = static_cast<const Value *>(mem);
+        Value tmp[N][Derived::Size];
+        for (size_t i = 0; i < Derived::Size; ++i)
+            for (size_t j = 0; j < N; ++j)
+                tmp[j][i] = in[i * N + j];
+
+        for (size_t j = 0; j < N; ++j)
+            out[j] = load<Derived>(tmp[j]);
+    }
+
+    /// Store 'N' packets as interleaved records (see \ref store_aos())
+    template <size_t N>
+    static void store_aos_(void *mem, const Derived *in) {
+        static_assert(drjit::detail::is_scalar_v<Value>,
+                      "store_aos(): expected an array of packets!");
+
+        Value *out = static_cast<Value *>(mem);
+        Value tmp[N][Derived::Size];
+        for (size_t j = 0; j < N; ++j)
+            store(tmp[j], in[j]);
+
+        for (size_t i = 0; i < Derived::Size; ++i)
+            for (size_t j = 0; j < N; ++j)
+                out[i * N + j] = tmp[j][i];
+    }
+
     DRJIT_INLINE decltype(auto) x() const {
         static_assert(Derived::ActualSize >= 1, "StaticArrayBase::x(): requires Size >= 1");
         return derived().entry(0);
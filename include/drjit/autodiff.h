@@ -53,6 +53,12 @@ enum class ADFlag : uint32_t {
     /// Don't fail when the input to a ``dr::forward`` or ``backward`` operation
     /// is not a differentiable array.
     AllowNoGrad = 8,
+
+    /// Group the enqueued edges into dependency levels and propagate
+    /// gradients along independent edges of each level using the nanothread
+    /// thread pool. The accumulation order does not depend on the number of
+    /// threads, hence the result is deterministic.
+    ParallelTraversal = 16,
 };
 
 constexpr uint32_t operator |(ADFlag f1, ADFlag f2)   { return (uint32_t) f1 | (uint32_t) f2; }
@@ -183,4 +183,143 @@ typename Op::Output custom(const Inputs &...inputs) {
     return output;
 }
 
+NAMESPACE_BEGIN(detail)
+
+/// Custom operation underlying \ref checkpoint()
+template <typename Func, typename Output, typename... Input>
+class CheckpointOp : public CustomOpBase {
+public:
+    using Inputs = drjit::tuple<Input...>;
+
+    CheckpointOp(const Func &func, const Input &...in)
+        : m_func(func), m_primal(detach(in)...),
+          m_inputs(ad_scan(*this, Inputs(in...), true)) { }
+
+    void forward() override {
+        Inputs inputs;
+        Output output = rematerialize(inputs);
+        accum_grad(inputs, grad(m_inputs));
+        enqueue(ADMode::Forward, inputs);
+        traverse(ADMode::Forward);
+        accum_grad(m_output, grad(output));
+    }
+
+    void backward() override {
+        Inputs inputs;
+        Output output = rematerialize(inputs);
+        accum_grad(output, grad(m_output));
+        enqueue(ADMode::Backward, output);
+        traverse(ADMode::Backward);
+        accum_grad(m_inputs, grad(inputs));
+    }
+
+    const char *name() const override { return "checkpoint"; }
+
+    /// Evaluate the function without recording anything on the AD graph
+    Output eval() {
+        ad_scope_enter(ADScope::Suspend, 0, nullptr);
+        try {
+            Output output = call(m_primal, std::index_sequence_for<Input...>());
+            ad_scope_leave(false);
+            return output;
+        } catch (...) {
+            ad_scope_leave(false);
+            throw;
+        }
+    }
+
+    /// Register the (fresh) AD variables representing the output
+    void set_output(const Output &output) {
+        m_output = ad_scan(*this, output, false);
+    }
+
+private:
+    template <size_t... Is>
+    Output call(const Inputs &inputs, std::index_sequence<Is...>) {
+        return m_func(drjit::get<Is>(inputs)...);
+    }
+
+    /**
+     * \brief Re-evaluate the function while tracking derivatives with respect
+     * to fresh AD variables representing the differentiable inputs
+     */
+    Output rematerialize(Inputs &inputs) {
+        index64_vector primal_i;
+        vector<uint64_t> input_i, enabled;
+        collect_indices<true>(m_primal, primal_i);
+        collect_indices<false>(m_inputs, input_i);
+
+        for (size_t i = 0; i < primal_i.size(); ++i) {
+            if (!(input_i[i] >> 32))
+                continue;
+            uint64_t index = ad_var_new((uint32_t) primal_i[i]);
+            ad_var_dec_ref(primal_i[i]);
+            primal_i[i] = index;
+            enabled.push_back(index);
+        }
+
+        inputs = m_primal;
+        update_indices(inputs, primal_i);
+
+        // An empty list would resume tracking of all variables
+        if (enabled.empty())
+            enabled.push_back(0);
+
+        ad_scope_enter(ADScope::Suspend, 0, nullptr);
+        ad_scope_enter(ADScope::Resume, enabled.size(), enabled.data());
+        try {
+            Output output = call(inputs, std::index_sequence_for<Input...>());
+            ad_scope_leave(false);
+            ad_scope_leave(false);
+            return output;
+        } catch (...) {
+            ad_scope_leave(false);
+            ad_scope_leave(false);
+            throw;
+        }
+    }
+
+private:
+    Func m_func;
+    Inputs m_primal;
+    Inputs m_inputs;
+    Output m_output;
+};
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Evaluate ``func(inputs...)`` without recording its interior on the
+ * AD graph, and recompute it when derivatives are propagated through it.
+ *
+ * Only the inputs and outputs of the function are tracked by the AD system.
+ * When a forward or backward traversal reaches the operation, the function is
+ * evaluated once more with derivative tracking enabled, and derivatives are
+ * propagated through this temporary graph. This trades computation for a
+ * reduced memory footprint of long differentiable computations.
+ *
+ * Derivatives are only tracked with respect to the provided inputs. The
+ * function must return a Dr.Jit array or a type declared via
+ * ``DRJIT_STRUCT``.
+ */
+template <typename Func, typename... Inputs>
+auto checkpoint(const Func &func, const Inputs &...inputs) {
+    using Output = std::decay_t<decltype(func(inputs...))>;
+    using Op = detail::CheckpointOp<Func, Output, Inputs...>;
+
+    nanobind::ref<Op> op = new Op(func, inputs...);
+
+    Output output = op->eval();
+
+    // Register the output with the AD layer (see custom() above)
+    detail::new_grad(output);
+
+    op->set_output(output);
+
+    if (!ad_custom_op(op.get()))
+        disable_grad(output);
+
+    return output;
+}
+
 NAMESPACE_END(drjit)
@@ -190,6 +190,27 @@ extern DRJIT_EXTRA_EXPORT uint64_t ad_var_cast(uint64_t, VarType);
 extern DRJIT_EXTRA_EXPORT void ad_enqueue(drjit::ADMode, uint64_t);
 extern DRJIT_EXTRA_EXPORT void ad_traverse(drjit::ADMode, uint32_t);
 
+/**
+ * \brief Limit the estimated size (in bytes) of gradients that AD traversal
+ * accumulates before evaluating them. A value of zero disables the limit.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_set_memory_budget(size_t size);
+
+/// Return the value previously set via \ref ad_set_memory_budget()
+extern DRJIT_EXTRA_EXPORT size_t ad_memory_budget();
+
+/**
+ * \brief Collapse chains of simple edges through otherwise unreferenced
+ * variables into composite edges. Returns the number of removed variables.
+ */
+extern DRJIT_EXTRA_EXPORT size_t ad_compact_graph();
+
+/**
+ * \brief Automatically compact the AD graph when the number of variables
+ * exceeds the given value. A value of zero disables this feature.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_set_compact_threshold(size_t size);
+
 /// Label a variable (useful for debugging via graphviz etc.)
 extern DRJIT_EXTRA_EXPORT uint64_t ad_var_set_label(uint64_t index, size_t argc, ...);
 
@@ -326,6 +347,82 @@ ad_call(JitBackend backend, const char *domain, int symbolic, size_t callable_co
         void *payload, ad_call_func callback, ad_call_cleanup cleanup,
         bool ad);
 
+/**
+ * \brief Sort the entries of symbolic calls by callee before dispatching them
+ *
+ * When enabled, \ref ad_call() computes a permutation that groups entries
+ * targeting the same callable (via a counting sort), dispatches the call on
+ * the permuted arguments, and finally undoes the permutation. This improves
+ * the coherence of the generated code at the cost of a few extra kernels.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_call_set_sort_by_callee(bool value);
+
+/// Return the value previously set via \ref ad_call_set_sort_by_callee()
+extern DRJIT_EXTRA_EXPORT bool ad_call_sort_by_callee();
+
+/**
+ * \brief Launch the kernels of evaluated calls in one batch
+ *
+ * Evaluated calls normally launch the kernel of each instance before tracing
+ * the next one. When enabled, \ref ad_call() first traces all instances and
+ * then launches their kernels with a single evaluation, followed by a merge
+ * of the return values.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_call_set_batched(bool value);
+
+/// Return the value previously set via \ref ad_call_set_batched()
+extern DRJIT_EXTRA_EXPORT bool ad_call_batched();
+
+/**
+ * \brief Merge small buckets of evaluated calls into a symbolic call
+ *
+ * When an evaluated call involves at least two callees with fewer than
+ * \c value entries, \ref ad_call() dispatches these entries using a single
+ * symbolic call instead of a separate kernel per callee. A value of zero (the
+ * default) disables this feature.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_call_set_small_bucket_threshold(size_t value);
+
+/// Return the value previously set via \ref ad_call_set_small_bucket_threshold()
+extern DRJIT_EXTRA_EXPORT size_t ad_call_small_bucket_threshold();
+
+/**
+ * \brief Inline the callee of vectorized calls whose active entries all
+ * target the same instance
+ *
+ * \ref ad_call() detects this case when the instance index is a literal, or
+ * by evaluating and reducing the index. It then directly invokes the callee instead
+ * of emitting an indirect call or evaluating the callee separately.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_call_set_devirtualize(bool value);
+
+/// Return the value previously set via \ref ad_call_set_devirtualize()
+extern DRJIT_EXTRA_EXPORT bool ad_call_devirtualize();
+
+/// Vectorized call that was inlined by \ref ad_call(), see \ref ad_call_history()
+struct CallHistoryEntry {
+    /// JIT backend of the call
+    JitBackend backend;
+    /// ID of the targeted instance
+    uint32_t instance;
+    /// Number of entries
+    size_t size;
+    /// Name of the call (should be freed by the caller via \c free())
+    char *name;
+};
+
+/**
+ * \brief Return and clear the list of inlined vectorized calls
+ *
+ * Calls are only recorded while \c JitFlag::KernelHistory is set. The
+ * returned array is terminated by an entry with an invalid backend, and it
+ * should be released via \c free().
+ */
+extern DRJIT_EXTRA_EXPORT struct CallHistoryEntry *ad_call_history();
+
+/// Clear the list of inlined vectorized calls
+extern DRJIT_EXTRA_EXPORT void ad_call_history_clear();
+
 // Callbacks used by \ref ad_loop() below. See the interface for details
 typedef void (*ad_loop_read)(void *payload, drjit::vector<uint64_t> &);
 typedef void (*ad_loop_write)(void *payload, const drjit::vector<uint64_t> &, bool restart);
@@ -347,14 +444,25 @@ typedef void (*ad_loop_delete)(void *payload);
  *     The JIT backend of the operation
  *
  * \param symbolic
- *     Set this to \c 0 for evaluated mode, \c 1 for symbolic mode, and \c -1
- *     to select the mode automatically.
+ *     Set this to \c 0 for evaluated mode, \c 1 for symbolic mode, \c 2 for
+ *     hybrid mode, and \c -1 to select the mode automatically. Hybrid loops
+ *     evaluate the loop state after every chunk of iterations (see \ref
+ *     ad_loop_set_hybrid_chunk_size()) and do not support differentiation.
  *
  * \param compress
  *     Set this to \c 1 for compress the state of evaluated loops at each
  *     operation, \c 0 to use a simpler masking-based implementation, and \c -1
  *     to select the mode automatically.
  *
+ * \param unroll
+ *     Set this to a value \c k greater than \c 1 to run \c k iterations per
+ *     invocation of the loop body. The additional iterations re-evaluate the
+ *     loop condition and mask inactive entries. A value of \c -1 fully
+ *     unrolls the loop into straight-line code, which requires a loop
+ *     condition that is a literal constant in every iteration (e.g., a loop
+ *     with a compile-time trip count). Set this to \c 0 or \c 1 to disable
+ *     unrolling.
+ *
  * \param name
  *     A descriptive name used in debug message / GraphViz visualizations
  *
@@ -394,12 +502,72 @@ typedef void (*ad_loop_delete)(void *payload);
  * already been destroyed.
  */
 extern DRJIT_EXTRA_EXPORT bool ad_loop(JitBackend backend, int symbolic, int compress,
-                                       long long max_iterations,
+                                       long long max_iterations, int unroll,
                                        const char *name, void *payload,
                                        ad_loop_read read_cb, ad_loop_write write_cb,
                                        ad_loop_cond cond_cb, ad_loop_body body_cb,
                                        ad_loop_delete delete_cb, bool ad);
 
+/// Statistics of evaluated loops with state compression, see \ref ad_loop_stats()
+struct LoopStats {
+    /// Number of executed loop iterations
+    uint64_t iterations;
+    /// Number of iterations that reduced the size of the loop state
+    uint64_t compressions;
+    /// Number of iterations that postponed compression and masked entries instead
+    uint64_t masked;
+    /// Number of entries processed by the loop body, summed over iterations
+    uint64_t lanes;
+    /// Number of active entries among them
+    uint64_t active_lanes;
+};
+
+/**
+ * \brief Set the occupancy threshold of evaluated loops with state compression
+ *
+ * Such loops only compress their state when the fraction of active entries
+ * falls to or below this value, and mask inactive entries otherwise. The
+ * default value of \c 1 compresses the loop state in every iteration.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_loop_set_compress_threshold(float value);
+
+/// Return the value previously set via \ref ad_loop_set_compress_threshold()
+extern DRJIT_EXTRA_EXPORT float ad_loop_compress_threshold();
+
+/**
+ * \brief Set the number of loop iterations per kernel of hybrid loops. The
+ * default value of \c 0 adapts it to the fraction of entries that remain
+ * active in each chunk.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_loop_set_hybrid_chunk_size(uint32_t value);
+
+/// Return the value previously set via \ref ad_loop_set_hybrid_chunk_size()
+extern DRJIT_EXTRA_EXPORT uint32_t ad_loop_hybrid_chunk_size();
+
+/**
+ * \brief Set the number of intermediate loop states that the reverse-mode
+ * derivative of a symbolic loop may store at once
+ *
+ * The derivative replays the loop and recomputes intermediate states from
+ * checkpoints placed following a binomial schedule. Memory usage then grows
+ * with the budget instead of the iteration count, at the cost of additional
+ * recomputation. The default value of \c 0 stores the state of every
+ * iteration.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_loop_set_checkpoint_budget(uint32_t value);
+
+/// Return the value previously set via \ref ad_loop_set_checkpoint_budget()
+extern DRJIT_EXTRA_EXPORT uint32_t ad_loop_checkpoint_budget();
+
+/**
+ * \brief Query the accumulated statistics of evaluated loops with state
+ * compression and the given name. Returns \c false if no such loop ran.
+ */
+extern DRJIT_EXTRA_EXPORT bool ad_loop_stats(const char *name, struct LoopStats *out);
+
+/// Clear the statistics reported by \ref ad_loop_stats()
+extern DRJIT_EXTRA_EXPORT void ad_loop_clear_stats();
+
 // Callbacks used by \ref ad_cond() below. See the interface for details
 typedef void (*ad_cond_body)(void *payload, bool value,
                              const drjit::vector<uint64_t> &args_i,
@@ -460,6 +628,20 @@ ad_cond(JitBackend backend, int symbolic, const char *name, void *payload,
         drjit::vector<uint64_t> &rv, ad_cond_body body_cb,
         ad_cond_delete delete_cb, bool ad);
 
+/**
+ * \brief Set the minimum size of evaluated conditionals that run sparse
+ * branches on a compacted subset of the entries (0: disabled, the default)
+ *
+ * When a branch of such a conditional covers at most half of the entries,
+ * \ref ad_cond() gathers the affected arguments, runs the branch on the
+ * active entries only, and scatters the results back. Otherwise, it falls
+ * back to masking.
+ */
+extern DRJIT_EXTRA_EXPORT void ad_cond_set_compact_threshold(size_t value);
+
+/// Return the value previously set via \ref ad_cond_set_compact_threshold()
+extern DRJIT_EXTRA_EXPORT size_t ad_cond_compact_threshold();
+
 /// Inform the AD layer that a state variable is temporarily being rewritten
 /// by a symbolic operation
 extern DRJIT_EXTRA_EXPORT void ad_var_map_put(uint64_t source, uint64_t target);
@@ -311,6 +311,75 @@ Array transpose(const Array &a) {
                     _mm256_permute2f128_pd(t1, t3, 0b0011'0001),
                     _mm256_permute2f128_pd(t0, t2, 0b0011'0001)
                 );
+            } else if constexpr (std::is_same_v<value_t<Row>, float> && Size == 8) {
+                __m256 r0 = a.entry(0).m, r1 = a.entry(1).m,
+                       r2 = a.entry(2).m, r3 = a.entry(3).m,
+                       r4 = a.entry(4).m, r5 = a.entry(5).m,
+                       r6 = a.entry(6).m, r7 = a.entry(7).m;
+
+                // 4x4 transposes within each 128-bit lane ..
+                __m256 t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpackhi_ps(r0, r1),
+                       t2 = _mm256_unpacklo_ps(r2, r3), t3 = _mm256_unpackhi_ps(r2, r3),
+                       t4 = _mm256_unpacklo_ps(r4, r5), t5 = _mm256_unpackhi_ps(r4, r5),
+                       t6 = _mm256_unpacklo_ps(r6, r7), t7 = _mm256_unpackhi_ps(r6, r7);
+
+                __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)),
+                       s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)),
+                       s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+                       s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)),
+                       s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0)),
+                       s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2)),
+                       s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0)),
+                       s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+                // .. followed by an exchange of the off-diagonal blocks
+                return Array(
+                    _mm256_permute2f128_ps(s0, s4, 0b0010'0000),
+                    _mm256_permute2f128_ps(s1, s5, 0b0010'0000),
+                    _mm256_permute2f128_ps(s2, s6, 0b0010'0000),
+                    _mm256_permute2f128_ps(s3, s7, 0b0010'0000),
+                    _mm256_permute2f128_ps(s0, s4, 0b0011'0001),
+                    _mm256_permute2f128_ps(s1, s5, 0b0011'0001),
+                    _mm256_permute2f128_ps(s2, s6, 0b0011'0001),
+                    _mm256_permute2f128_ps(s3, s7, 0b0011'0001)
+                );
+            }
+        #endif
+
+        #if defined(DRJIT_X86_AVX512)
+            if constexpr (std::is_same_v<value_t<Row>, double> && Size == 8) {
+                __m512d r0 = a.entry(0).m, r1 = a.entry(1).m,
+                        r2 = a.entry(2).m, r3 = a.entry(3).m,
+                        r4 = a.entry(4).m, r5 = a.entry(5).m,
+                        r6 = a.entry(6).m, r7 = a.entry(7).m;
+
+                __m512d t0 = _mm512_unpacklo_pd(r0, r1), t1 = _mm512_unpackhi_pd(r0, r1),
+                        t2 = _mm512_unpacklo_pd(r2, r3), t3 = _mm512_unpackhi_pd(r2, r3),
+                        t4 = _mm512_unpacklo_pd(r4, r5), t5 = _mm512_unpackhi_pd(r4, r5),
+                        t6 = _mm512_unpacklo_pd(r6, r7), t7 = _mm512_unpackhi_pd(r6, r7);
+
+                const __m512i lo = _mm512_setr_epi64(0, 1, 8, 9, 4, 5, 12, 13),
+                              hi = _mm512_setr_epi64(2, 3, 10, 11, 6, 7, 14, 15);
+
+                __m512d s0 = _mm512_permutex2var_pd(t0, lo, t2),
+                        s1 = _mm512_permutex2var_pd(t1, lo, t3),
+                        s2 = _mm512_permutex2var_pd(t0, hi, t2),
+                        s3 = _mm512_permutex2var_pd(t1, hi, t3),
+                        s4 = _mm512_permutex2var_pd(t4, lo, t6),
+                        s5 = _mm512_permutex2var_pd(t5, lo, t7),
+                        s6 = _mm512_permutex2var_pd(t4, hi, t6),
+                        s7 = _mm512_permutex2var_pd(t5, hi, t7);
+
+                return Array(
+                    _mm512_shuffle_f64x2(s0, s4, 0b0100'0100),
+                    _mm512_shuffle_f64x2(s1, s5, 0b0100'0100),
+                    _mm512_shuffle_f64x2(s2, s6, 0b0100'0100),
+                    _mm512_shuffle_f64x2(s3, s7, 0b0100'0100),
+                    _mm512_shuffle_f64x2(s0, s4, 0b1110'1110),
+                    _mm512_shuffle_f64x2(s1, s5, 0b1110'1110),
+                    _mm512_shuffle_f64x2(s2, s6, 0b1110'1110),
+                    _mm512_shuffle_f64x2(s3, s7, 0b1110'1110)
+                );
             }
         #endif
 
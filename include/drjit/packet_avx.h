@@ -40,10 +40,9 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     //! @{ \name Type converting constructors
     // -----------------------------------------------------------------------
 
-// #if defined(DRJIT_X86_F16C)
-//     DRJIT_CONVERT(half)
-//         : m(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) a.derived().data()))) { }
-// #endif
+#if defined(DRJIT_X86_F16C)
+    DRJIT_CONVERT(half) : m(_mm256_cvtph_ps(a.derived().m)) { }
+#endif
 
     DRJIT_CONVERT(float) : m(a.derived().m) { }
 
@@ -407,6 +406,76 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     static DRJIT_INLINE Derived empty_(size_t) { return _mm256_undefined_ps(); }
     static DRJIT_INLINE Derived zero_(size_t) { return _mm256_setzero_ps(); }
 
+    /* The AoS <-> SoA conversions below place records 0-3 in the low and
+       records 4-7 in the high 128-bit lane, which reduces them to the
+       in-lane SSE shuffles of the 4-wide case */
+    template <size_t N>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        const float *p = (const float *) ptr;
+        if constexpr (N == 2) {
+            __m256 a = detail::mm256_loadu2_ps(p,     p + 8),
+                   b = detail::mm256_loadu2_ps(p + 4, p + 12);
+            out[0] = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            out[1] = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        } else if constexpr (N == 3) {
+            __m256 a = detail::mm256_loadu2_ps(p,     p + 12),
+                   b = detail::mm256_loadu2_ps(p + 4, p + 16),
+                   c = detail::mm256_loadu2_ps(p + 8, p + 20);
+
+            __m256 x = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x44), c, 0x22),
+                   y = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x99), c, 0x44),
+                   z = _mm256_blend_ps(_mm256_blend_ps(a, b, 0x22), c, 0x99);
+
+            out[0] = _mm256_permute_ps(x, _MM_SHUFFLE(1, 2, 3, 0));
+            out[1] = _mm256_permute_ps(y, _MM_SHUFFLE(2, 3, 0, 1));
+            out[2] = _mm256_permute_ps(z, _MM_SHUFFLE(3, 0, 1, 2));
+        } else if constexpr (N == 4) {
+            __m256 r0 = detail::mm256_loadu2_ps(p,      p + 16),
+                   r1 = detail::mm256_loadu2_ps(p + 4,  p + 20),
+                   r2 = detail::mm256_loadu2_ps(p + 8,  p + 24),
+                   r3 = detail::mm256_loadu2_ps(p + 12, p + 28);
+
+            __m256 t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpacklo_ps(r2, r3),
+                   t2 = _mm256_unpackhi_ps(r0, r1), t3 = _mm256_unpackhi_ps(r2, r3);
+
+            out[0] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+            out[1] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+            out[2] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            out[3] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        } else {
+            Base::template load_aos_<N>(ptr, out);
+        }
+    }
+
+    template <size_t N>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        float *p = (float *) ptr;
+        if constexpr (N == 2) {
+            detail::mm256_storeu2_ps(p,     p + 8,  _mm256_unpacklo_ps(in[0].m, in[1].m));
+            detail::mm256_storeu2_ps(p + 4, p + 12, _mm256_unpackhi_ps(in[0].m, in[1].m));
+        } else if constexpr (N == 3) {
+            __m256 x = _mm256_permute_ps(in[0].m, _MM_SHUFFLE(1, 2, 3, 0)),
+                   y = _mm256_permute_ps(in[1].m, _MM_SHUFFLE(2, 3, 0, 1)),
+                   z = _mm256_permute_ps(in[2].m, _MM_SHUFFLE(3, 0, 1, 2));
+
+            detail::mm256_storeu2_ps(p,     p + 12, _mm256_blend_ps(_mm256_blend_ps(x, y, 0x22), z, 0x44));
+            detail::mm256_storeu2_ps(p + 4, p + 16, _mm256_blend_ps(_mm256_blend_ps(y, z, 0x22), x, 0x44));
+            detail::mm256_storeu2_ps(p + 8, p + 20, _mm256_blend_ps(_mm256_blend_ps(z, x, 0x22), y, 0x44));
+        } else if constexpr (N == 4) {
+            __m256 t0 = _mm256_unpacklo_ps(in[0].m, in[1].m),
+                   t1 = _mm256_unpacklo_ps(in[2].m, in[3].m),
+                   t2 = _mm256_unpackhi_ps(in[0].m, in[1].m),
+                   t3 = _mm256_unpackhi_ps(in[2].m, in[3].m);
+
+            detail::mm256_storeu2_ps(p,      p + 16, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)));
+            detail::mm256_storeu2_ps(p + 4,  p + 20, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2)));
+            detail::mm256_storeu2_ps(p + 8,  p + 24, _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+            detail::mm256_storeu2_ps(p + 12, p + 28, _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+        } else {
+            Base::template store_aos_<N>(ptr, in);
+        }
+    }
+
 #if defined(DRJIT_X86_AVX2)
     template <typename Index, typename Mask>
     static DRJIT_INLINE Derived gather_(const void *ptr, const Index &index, const Mask &mask, ReduceMode) {
@@ -437,6 +506,43 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     }
 #endif
 
+#if defined(DRJIT_X86_AVX512)
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        _mm256_mask_compressstoreu_ps(ptr, mask.k, m);
+        return (size_t) _mm_popcnt_u32((unsigned int) mask.k);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        return _mm256_maskz_expandloadu_ps(mask.k, ptr);
+    }
+#elif defined(DRJIT_X86_AVX2)
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        uint32_t bits = mask.bitmask_(),
+                 count = (uint32_t) _mm_popcnt_u32(bits);
+        __m256i perm = detail::mm256_decode_perm_epi32(
+            detail::compress_tables.compress[bits]);
+        _mm256_maskstore_ps((float *) ptr,
+                            detail::mm256_prefix_mask_epi32(count),
+                            _mm256_permutevar8x32_ps(m, perm));
+        return (size_t) count;
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        uint32_t bits = mask.bitmask_(),
+                 count = (uint32_t) _mm_popcnt_u32(bits);
+        __m256i perm = detail::mm256_decode_perm_epi32(
+            detail::compress_tables.expand[bits]);
+        __m256 packed = _mm256_maskload_ps(
+            (const float *) ptr, detail::mm256_prefix_mask_epi32(count));
+        return _mm256_and_ps(_mm256_permutevar8x32_ps(packed, perm),
+                             _mm256_castsi256_ps(detail::mm256_movemask_inv_epi32(bits)));
+    }
+#endif
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -464,12 +570,12 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     //! @{ \name Type converting constructors
     // -----------------------------------------------------------------------
 
-// #if defined(DRJIT_X86_F16C)
-//     DRJIT_CONVERT(half) {
-//         m = _mm256_cvtps_pd(
-//             _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) a.derived().data())));
-//     }
-// #endif
+#if defined(DRJIT_X86_F16C)
+    DRJIT_CONVERT(half) {
+        m = _mm256_cvtps_pd(
+            _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) a.derived().data())));
+    }
+#endif
 
     DRJIT_CONVERT(float) : m(_mm256_cvtps_pd(a.derived().m)) { }
     DRJIT_CONVERT(int32_t) : m(_mm256_cvtepi32_pd(a.derived().m)) { }
@@ -772,6 +878,66 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     static DRJIT_INLINE Derived empty_(size_t) { return _mm256_undefined_pd(); }
     static DRJIT_INLINE Derived zero_(size_t) { return _mm256_setzero_pd(); }
 
+    /// Records 0-1 go to the low and records 2-3 to the high 128-bit lane
+    template <size_t N>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        const double *p = (const double *) ptr;
+        if constexpr (Derived::Size == 4 && N == 2) {
+            __m256d a = detail::mm256_loadu2_pd(p,     p + 4),
+                    b = detail::mm256_loadu2_pd(p + 2, p + 6);
+            out[0] = _mm256_unpacklo_pd(a, b);
+            out[1] = _mm256_unpackhi_pd(a, b);
+        } else if constexpr (Derived::Size == 4 && N == 3) {
+            // a = (x0 y0 | x2 y2), b = (z0 x1 | z2 x3), c = (y1 z1 | y3 z3)
+            __m256d a = detail::mm256_loadu2_pd(p,     p + 6),
+                    b = detail::mm256_loadu2_pd(p + 2, p + 8),
+                    c = detail::mm256_loadu2_pd(p + 4, p + 10);
+            out[0] = _mm256_blend_pd(a, b, 0b1010);
+            out[1] = _mm256_shuffle_pd(a, c, 0b0101);
+            out[2] = _mm256_blend_pd(b, c, 0b1010);
+        } else if constexpr (Derived::Size == 4 && N == 4) {
+            __m256d r0 = _mm256_loadu_pd(p),     r1 = _mm256_loadu_pd(p + 4),
+                    r2 = _mm256_loadu_pd(p + 8), r3 = _mm256_loadu_pd(p + 12);
+
+            __m256d t3 = _mm256_shuffle_pd(r2, r3, 0b0000),
+                    t2 = _mm256_shuffle_pd(r2, r3, 0b1111),
+                    t1 = _mm256_shuffle_pd(r0, r1, 0b0000),
+                    t0 = _mm256_shuffle_pd(r0, r1, 0b1111);
+
+            out[0] = _mm256_permute2f128_pd(t1, t3, 0b0010'0000);
+            out[1] = _mm256_permute2f128_pd(t0, t2, 0b0010'0000);
+            out[2] = _mm256_permute2f128_pd(t1, t3, 0b0011'0001);
+            out[3] = _mm256_permute2f128_pd(t0, t2, 0b0011'0001);
+        } else {
+            Base::template load_aos_<N>(ptr, out);
+        }
+    }
+
+    template <size_t N>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        double *p = (double *) ptr;
+        if constexpr (Derived::Size == 4 && N == 2) {
+            detail::mm256_storeu2_pd(p,     p + 4, _mm256_unpacklo_pd(in[0].m, in[1].m));
+            detail::mm256_storeu2_pd(p + 2, p + 6, _mm256_unpackhi_pd(in[0].m, in[1].m));
+        } else if constexpr (Derived::Size == 4 && N == 3) {
+            detail::mm256_storeu2_pd(p,     p + 6,  _mm256_unpacklo_pd(in[0].m, in[1].m));
+            detail::mm256_storeu2_pd(p + 2, p + 8,  _mm256_blend_pd(in[2].m, in[0].m, 0b1010));
+            detail::mm256_storeu2_pd(p + 4, p + 10, _mm256_unpackhi_pd(in[1].m, in[2].m));
+        } else if constexpr (Derived::Size == 4 && N == 4) {
+            __m256d t3 = _mm256_shuffle_pd(in[2].m, in[3].m, 0b0000),
+                    t2 = _mm256_shuffle_pd(in[2].m, in[3].m, 0b1111),
+                    t1 = _mm256_shuffle_pd(in[0].m, in[1].m, 0b0000),
+                    t0 = _mm256_shuffle_pd(in[0].m, in[1].m, 0b1111);
+
+            _mm256_storeu_pd(p,      _mm256_permute2f128_pd(t1, t3, 0b0010'0000));
+            _mm256_storeu_pd(p + 4,  _mm256_permute2f128_pd(t0, t2, 0b0010'0000));
+            _mm256_storeu_pd(p + 8,  _mm256_permute2f128_pd(t1, t3, 0b0011'0001));
+            _mm256_storeu_pd(p + 12, _mm256_permute2f128_pd(t0, t2, 0b0011'0001));
+        } else {
+            Base::template store_aos_<N>(ptr, in);
+        }
+    }
+
 #if defined(DRJIT_X86_AVX2)
     template <typename Index, typename Mask>
     static DRJIT_INLINE Derived gather_(const void *ptr, const Index &index, const Mask &mask, bool) {
@@ -799,6 +965,60 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     }
 #endif
 
+#if defined(DRJIT_X86_AVX512)
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        if constexpr (Derived::Size == 4) {
+            _mm256_mask_compressstoreu_pd(ptr, mask.k, m);
+            return (size_t) _mm_popcnt_u32((unsigned int) mask.k);
+        } else {
+            return Base::compress_store_(ptr, mask);
+        }
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        if constexpr (Derived::Size == 4)
+            return _mm256_maskz_expandloadu_pd(mask.k, ptr);
+        else
+            return Base::expand_load_(ptr, mask);
+    }
+#elif defined(DRJIT_X86_AVX2)
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        if constexpr (Derived::Size == 4) {
+            uint32_t bits = mask.bitmask_(),
+                     count = (uint32_t) _mm_popcnt_u32(bits);
+            __m256i perm = detail::mm256_decode_perm_epi32(
+                detail::compress_tables.compress64[bits]);
+            __m256 value = _mm256_permutevar8x32_ps(_mm256_castpd_ps(m), perm);
+            _mm256_maskstore_pd((double *) ptr,
+                                detail::mm256_prefix_mask_epi32(2 * count),
+                                _mm256_castps_pd(value));
+            return (size_t) count;
+        } else {
+            return Base::compress_store_(ptr, mask);
+        }
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        if constexpr (Derived::Size == 4) {
+            uint32_t bits = mask.bitmask_(),
+                     count = (uint32_t) _mm_popcnt_u32(bits);
+            __m256i perm = detail::mm256_decode_perm_epi32(
+                detail::compress_tables.expand64[bits]);
+            __m256d packed = _mm256_maskload_pd(
+                (const double *) ptr, detail::mm256_prefix_mask_epi32(2 * count));
+            __m256 value = _mm256_permutevar8x32_ps(_mm256_castpd_ps(packed), perm);
+            return _mm256_and_pd(_mm256_castps_pd(value),
+                                 _mm256_castsi256_pd(detail::mm256_movemask_inv_epi64(bits)));
+        } else {
+            return Base::expand_load_(ptr, mask);
+        }
+    }
+#endif
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -912,4 +1132,291 @@ template <typename Derived_>
 DRJIT_DECLARE_KMASK(double, 3, Derived_, int)
 #endif
 
+#if defined(DRJIT_X86_F16C)
+NAMESPACE_BEGIN(detail)
+template <> struct vectorize_half<half, 8> { static constexpr bool self = true; };
+NAMESPACE_END(detail)
+
+/**
+ * \brief Partial overload of StaticArrayImpl using F16C intrinsics (half
+ * precision)
+ *
+ * The values are kept in their compact 16-bit form. Arithmetic converts them
+ * to single precision, evaluates the operation using AVX instructions, and
+ * rounds the result back to half precision. When AVX512-FP16 is available,
+ * the arithmetic is instead evaluated natively.
+ */
+template <bool IsMask_, typename Derived_> struct alignas(16)
+    StaticArrayImpl<half, 8, IsMask_, Derived_, enable_if_t<!IsMask_>>
+  : StaticArrayBase<half, 8, IsMask_, Derived_> {
+    DRJIT_PACKET_TYPE(half, 8, __m128i)
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Value constructors
+    // -----------------------------------------------------------------------
+
+    template <typename T, enable_if_scalar_t<T> = 0>
+    DRJIT_INLINE StaticArrayImpl(T value)
+        : m(_mm_set1_epi16(memcpy_cast<short>(half((float) value)))) { }
+
+    DRJIT_INLINE StaticArrayImpl(Value v0, Value v1, Value v2, Value v3,
+                                 Value v4, Value v5, Value v6, Value v7)
+        : m(_mm_setr_epi16(
+              memcpy_cast<short>(v0), memcpy_cast<short>(v1),
+              memcpy_cast<short>(v2), memcpy_cast<short>(v3),
+              memcpy_cast<short>(v4), memcpy_cast<short>(v5),
+              memcpy_cast<short>(v6), memcpy_cast<short>(v7))) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Type converting constructors
+    // -----------------------------------------------------------------------
+
+    DRJIT_CONVERT(half) : m(a.derived().m) { }
+
+    DRJIT_CONVERT(float) : m(detail::mm256_cvtps_ph(a.derived().m)) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Reinterpreting constructors, mask converters
+    // -----------------------------------------------------------------------
+
+    DRJIT_REINTERPRET(half) : m(a.derived().m) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Converting from/to half size vectors
+    // -----------------------------------------------------------------------
+
+    StaticArrayImpl(const Array1 &a1, const Array2 &a2)
+        : m(_mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) a1.data()),
+                               _mm_loadl_epi64((const __m128i *) a2.data()))) { }
+
+    DRJIT_INLINE Array1 low_()  const { return Array1(entry(0), entry(1), entry(2), entry(3)); }
+    DRJIT_INLINE Array2 high_() const { return Array2(entry(4), entry(5), entry(6), entry(7)); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Vertical operations
+    // -----------------------------------------------------------------------
+
+#if defined(DRJIT_X86_AVX512FP16)
+    #define DRJIT_HALF_OP(name, op)                                            \
+        DRJIT_INLINE Derived name##_(Ref a) const {                            \
+            return _mm_castph_si128(_mm_##op##_ph(_mm_castsi128_ph(m),         \
+                                                  _mm_castsi128_ph(a.m)));     \
+        }
+#else
+    #define DRJIT_HALF_OP(name, op)                                            \
+        DRJIT_INLINE Derived name##_(Ref a) const {                            \
+            return detail::mm256_cvtps_ph(_mm256_##op##_ps(                    \
+                _mm256_cvtph_ps(m), _mm256_cvtph_ps(a.m)));                    \
+        }
+#endif
+
+    DRJIT_HALF_OP(add, add)
+    DRJIT_HALF_OP(sub, sub)
+    DRJIT_HALF_OP(mul, mul)
+    DRJIT_HALF_OP(div, div)
+    DRJIT_HALF_OP(minimum, min)
+    DRJIT_HALF_OP(maximum, max)
+
+    #undef DRJIT_HALF_OP
+
+#if defined(DRJIT_X86_AVX512FP16)
+    #define DRJIT_HALF_FMA(name)                                               \
+        DRJIT_INLINE Derived name##_(Ref b, Ref c) const {                     \
+            return _mm_castph_si128(_mm_##name##_ph(_mm_castsi128_ph(m),       \
+                                                    _mm_castsi128_ph(b.m),     \
+                                                    _mm_castsi128_ph(c.m)));   \
+        }
+#elif defined(DRJIT_X86_FMA)
+    #define DRJIT_HALF_FMA(name)                                               \
+        DRJIT_INLINE Derived name##_(Ref b, Ref c) const {                     \
+            return detail::mm256_cvtps_ph(_mm256_##name##_ps(                  \
+                _mm256_cvtph_ps(m), _mm256_cvtph_ps(b.m),                      \
+                _mm256_cvtph_ps(c.m)));                                        \
+        }
+#endif
+
+#if defined(DRJIT_HALF_FMA)
+    DRJIT_HALF_FMA(fmadd)
+    DRJIT_HALF_FMA(fmsub)
+    DRJIT_HALF_FMA(fnmadd)
+    DRJIT_HALF_FMA(fnmsub)
+    #undef DRJIT_HALF_FMA
+#endif
+
+    DRJIT_INLINE Derived sqrt_() const {
+        #if defined(DRJIT_X86_AVX512FP16)
+            return _mm_castph_si128(_mm_sqrt_ph(_mm_castsi128_ph(m)));
+        #else
+            return detail::mm256_cvtps_ph(_mm256_sqrt_ps(_mm256_cvtph_ps(m)));
+        #endif
+    }
+
+    DRJIT_INLINE Derived rcp_() const {
+        return detail::mm256_cvtps_ph(
+            _mm256_div_ps(_mm256_set1_ps(1.f), _mm256_cvtph_ps(m)));
+    }
+
+    DRJIT_INLINE Derived rsqrt_() const {
+        return detail::mm256_cvtps_ph(_mm256_div_ps(
+            _mm256_set1_ps(1.f), _mm256_sqrt_ps(_mm256_cvtph_ps(m))));
+    }
+
+    #define DRJIT_HALF_ROUND(name, mode)                                       \
+        DRJIT_INLINE Derived name##_() const {                                 \
+            return detail::mm256_cvtps_ph(_mm256_round_ps(                     \
+                _mm256_cvtph_ps(m), mode | _MM_FROUND_NO_EXC));                \
+        }
+
+    DRJIT_HALF_ROUND(floor, _MM_FROUND_TO_NEG_INF)
+    DRJIT_HALF_ROUND(ceil, _MM_FROUND_TO_POS_INF)
+    DRJIT_HALF_ROUND(round, _MM_FROUND_TO_NEAREST_INT)
+    DRJIT_HALF_ROUND(trunc, _MM_FROUND_TO_ZERO)
+
+    #undef DRJIT_HALF_ROUND
+
+    DRJIT_INLINE Derived neg_() const {
+        return _mm_xor_si128(m, _mm_set1_epi16((short) 0x8000));
+    }
+
+    DRJIT_INLINE Derived abs_() const {
+        return _mm_andnot_si128(_mm_set1_epi16((short) 0x8000), m);
+    }
+
+    DRJIT_INLINE Derived not_() const {
+        return _mm_xor_si128(m, _mm_set1_epi32(-1));
+    }
+
+    template <typename T> DRJIT_INLINE Derived or_(const T &a) const {
+        return _mm_or_si128(m, bits_(a));
+    }
+
+    template <typename T> DRJIT_INLINE Derived and_(const T &a) const {
+        return _mm_and_si128(m, bits_(a));
+    }
+
+    template <typename T> DRJIT_INLINE Derived andnot_(const T &a) const {
+        return _mm_andnot_si128(bits_(a), m);
+    }
+
+    template <typename T> DRJIT_INLINE Derived xor_(const T &a) const {
+        return _mm_xor_si128(m, bits_(a));
+    }
+
+    #if defined(DRJIT_X86_AVX512FP16)
+        #define DRJIT_COMP(name, NAME) mask_t<Derived>::from_k(_mm_cmp_ph_mask(_mm_castsi128_ph(m), _mm_castsi128_ph(a.m), _CMP_##NAME))
+    #elif defined(DRJIT_X86_AVX512)
+        #define DRJIT_COMP(name, NAME) mask_t<Derived>::from_k(_mm256_cmp_ps_mask(_mm256_cvtph_ps(m), _mm256_cvtph_ps(a.m), _CMP_##NAME))
+    #else
+        #define DRJIT_COMP(name, NAME) mask_t<Derived>(_mm256_cmp_ps(_mm256_cvtph_ps(m), _mm256_cvtph_ps(a.m), _CMP_##NAME))
+    #endif
+
+    DRJIT_INLINE auto lt_ (Ref a) const { return DRJIT_COMP(lt,  LT_OQ);  }
+    DRJIT_INLINE auto gt_ (Ref a) const { return DRJIT_COMP(gt,  GT_OQ);  }
+    DRJIT_INLINE auto le_ (Ref a) const { return DRJIT_COMP(le,  LE_OQ);  }
+    DRJIT_INLINE auto ge_ (Ref a) const { return DRJIT_COMP(ge,  GE_OQ);  }
+    DRJIT_INLINE auto eq_ (Ref a) const { return DRJIT_COMP(eq,  EQ_OQ);  }
+    DRJIT_INLINE auto neq_(Ref a) const { return DRJIT_COMP(neq, NEQ_UQ); }
+
+    #undef DRJIT_COMP
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived select_(const Mask &m, Ref t, Ref f) {
+        return _mm_blendv_epi8(f.m, t.m, bits_(m));
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Horizontal operations
+    // -----------------------------------------------------------------------
+
+    #define DRJIT_HORIZONTAL_OP(name, op)                                      \
+        DRJIT_INLINE Value name##_() const {                                   \
+            __m256 v = _mm256_cvtph_ps(m);                                     \
+            __m128 t0 = _mm_##op##_ps(_mm256_castps256_ps128(v),               \
+                                      _mm256_extractf128_ps(v, 1));            \
+            __m128 t1 = _mm_movehdup_ps(t0);                                   \
+            __m128 t2 = _mm_##op##_ps(t0, t1);                                 \
+            t1 = _mm_movehl_ps(t1, t2);                                        \
+            t2 = _mm_##op##_ss(t2, t1);                                        \
+            return Value(_mm_cvtss_f32(t2));                                   \
+        }
+
+    DRJIT_HORIZONTAL_OP(sum, add)
+    DRJIT_HORIZONTAL_OP(prod, mul)
+    DRJIT_HORIZONTAL_OP(min, min)
+    DRJIT_HORIZONTAL_OP(max, max)
+
+    #undef DRJIT_HORIZONTAL_OP
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Initialization, loading/writing data
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE void store_aligned_(void *ptr) const {
+        _mm_store_si128((__m128i *) DRJIT_ASSUME_ALIGNED(ptr, 16), m);
+    }
+
+    DRJIT_INLINE void store_(void *ptr) const {
+        _mm_storeu_si128((__m128i *) ptr, m);
+    }
+
+    static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
+        return _mm_load_si128((const __m128i *) DRJIT_ASSUME_ALIGNED(ptr, 16));
+    }
+
+    static DRJIT_INLINE Derived load_(const void *ptr, size_t) {
+        return _mm_loadu_si128((const __m128i *) ptr);
+    }
+
+    static DRJIT_INLINE Derived empty_(size_t) { return _mm_undefined_si128(); }
+    static DRJIT_INLINE Derived zero_(size_t) { return _mm_setzero_si128(); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    /// Bit pattern of a half precision array or mask with 16-bit lanes
+    template <typename T> static DRJIT_INLINE __m128i bits_(const T &a) {
+        if constexpr (is_mask_v<T>) {
+            #if defined(DRJIT_X86_AVX512)
+                return _mm_movm_epi16(a.k);
+            #else
+                return detail::mm256_cvtmask_epi16(a.m);
+            #endif
+        } else {
+            return a.m;
+        }
+    }
+} DRJIT_MAY_ALIAS;
+
+/// Masks of half precision packets use the single precision representation
+template <bool IsMask_, typename Derived_> struct alignas(32)
+    StaticArrayImpl<half, 8, IsMask_, Derived_, enable_if_t<IsMask_>>
+  : StaticArrayImpl<float, 8, IsMask_, Derived_> {
+    using Base = StaticArrayImpl<float, 8, IsMask_, Derived_>;
+    DRJIT_ARRAY_IMPORT(StaticArrayImpl, Base)
+
+#if !defined(DRJIT_X86_AVX512)
+    DRJIT_INLINE auto eq_(const Derived_ &a) const { return Base::xor_(a).not_(); }
+    DRJIT_INLINE auto neq_(const Derived_ &a) const { return Base::xor_(a); }
+#endif
+} DRJIT_MAY_ALIAS;
+#endif
+
 NAMESPACE_END(drjit)
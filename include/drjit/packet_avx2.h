@@ -429,6 +429,39 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(32)
         #endif
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        #if defined(DRJIT_X86_AVX512)
+            _mm256_mask_compressstoreu_epi32(ptr, mask.k, m);
+            return (size_t) _mm_popcnt_u32((unsigned int) mask.k);
+        #else
+            uint32_t bits = mask.bitmask_(),
+                     count = (uint32_t) _mm_popcnt_u32(bits);
+            __m256i perm = detail::mm256_decode_perm_epi32(
+                detail::compress_tables.compress[bits]);
+            _mm256_maskstore_epi32((int *) ptr,
+                                   detail::mm256_prefix_mask_epi32(count),
+                                   _mm256_permutevar8x32_epi32(m, perm));
+            return (size_t) count;
+        #endif
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        #if defined(DRJIT_X86_AVX512)
+            return _mm256_maskz_expandloadu_epi32(mask.k, ptr);
+        #else
+            uint32_t bits = mask.bitmask_(),
+                     count = (uint32_t) _mm_popcnt_u32(bits);
+            __m256i perm = detail::mm256_decode_perm_epi32(
+                detail::compress_tables.expand[bits]);
+            __m256i packed = _mm256_maskload_epi32(
+                (const int *) ptr, detail::mm256_prefix_mask_epi32(count));
+            return _mm256_and_si256(_mm256_permutevar8x32_epi32(packed, perm),
+                                    detail::mm256_movemask_inv_epi32(bits));
+        #endif
+    }
+
 
     //! @}
     // -----------------------------------------------------------------------
@@ -877,6 +910,47 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(32)
         #endif
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        if constexpr (Derived::Size == 4) {
+            #if defined(DRJIT_X86_AVX512)
+                _mm256_mask_compressstoreu_epi64(ptr, mask.k, m);
+                return (size_t) _mm_popcnt_u32((unsigned int) mask.k);
+            #else
+                uint32_t bits = mask.bitmask_(),
+                         count = (uint32_t) _mm_popcnt_u32(bits);
+                __m256i perm = detail::mm256_decode_perm_epi32(
+                    detail::compress_tables.compress64[bits]);
+                _mm256_maskstore_epi64((long long *) ptr,
+                                       detail::mm256_prefix_mask_epi32(2 * count),
+                                       _mm256_permutevar8x32_epi32(m, perm));
+                return (size_t) count;
+            #endif
+        } else {
+            return Base::compress_store_(ptr, mask);
+        }
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        if constexpr (Derived::Size == 4) {
+            #if defined(DRJIT_X86_AVX512)
+                return _mm256_maskz_expandloadu_epi64(mask.k, ptr);
+            #else
+                uint32_t bits = mask.bitmask_(),
+                         count = (uint32_t) _mm_popcnt_u32(bits);
+                __m256i perm = detail::mm256_decode_perm_epi32(
+                    detail::compress_tables.expand64[bits]);
+                __m256i packed = _mm256_maskload_epi64(
+                    (const long long *) ptr, detail::mm256_prefix_mask_epi32(2 * count));
+                return _mm256_and_si256(_mm256_permutevar8x32_epi32(packed, perm),
+                                        detail::mm256_movemask_inv_epi64(bits));
+            #endif
+        } else {
+            return Base::expand_load_(ptr, mask);
+        }
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -43,8 +43,7 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
     //! @{ \name Type converting constructors
     // -----------------------------------------------------------------------
 
-    // DRJIT_CONVERT(half)
-    //     : m(_mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *) a.derived().data()))) { }
+    DRJIT_CONVERT(half) : m(_mm512_cvtph_ps(a.derived().m)) { }
 
     DRJIT_CONVERT(float) : m(a.derived().m) { }
 
@@ -273,6 +272,37 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
     static DRJIT_INLINE Derived empty_(size_t) { return _mm512_undefined_ps(); }
     static DRJIT_INLINE Derived zero_(size_t) { return _mm512_setzero_ps(); }
 
+    template <size_t N>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        if constexpr (N >= 2 && N <= 4) {
+            constexpr auto &t = detail::aos_tables<uint32_t, 16, N>;
+            __m512 r[N];
+            for (size_t k = 0; k < N; ++k)
+                r[k] = _mm512_loadu_ps((const float *) ptr + 16 * k);
+            for (size_t j = 0; j < N; ++j)
+                out[j] = detail::mm512_permute_aos_ps<N>(
+                    r, t.load_idx[j], (__mmask16) t.load_sel[j]);
+        } else {
+            Base::template load_aos_<N>(ptr, out);
+        }
+    }
+
+    template <size_t N>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        if constexpr (N >= 2 && N <= 4) {
+            constexpr auto &t = detail::aos_tables<uint32_t, 16, N>;
+            __m512 r[N];
+            for (size_t j = 0; j < N; ++j)
+                r[j] = in[j].m;
+            for (size_t k = 0; k < N; ++k)
+                _mm512_storeu_ps((float *) ptr + 16 * k,
+                                 detail::mm512_permute_aos_ps<N>(
+                                     r, t.store_idx[k], (__mmask16) t.store_sel[k]));
+        } else {
+            Base::template store_aos_<N>(ptr, in);
+        }
+    }
+
     template <typename Index, typename Mask>
     static DRJIT_INLINE Derived gather_(const void *ptr, const Index &index, const Mask &mask, ReduceMode) {
         if constexpr (sizeof(scalar_t<Index>) == 4) {
@@ -294,6 +324,17 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
         }
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        _mm512_mask_compressstoreu_ps(ptr, mask.k, m);
+        return (size_t) _mm_popcnt_u32((unsigned int) mask.k);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        return _mm512_maskz_expandloadu_ps(mask.k, ptr);
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -320,9 +361,8 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
     //! @{ \name Type converting constructors
     // -----------------------------------------------------------------------
 
-    // DRJIT_CONVERT(half)
-    //     : m(_mm512_cvtps_pd(
-    //           _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) a.derived().data())))) { }
+    DRJIT_CONVERT(half)
+        : m(_mm512_cvtps_pd(_mm256_cvtph_ps(a.derived().m))) { }
 
     DRJIT_CONVERT(float) : m(_mm512_cvtps_pd(a.derived().m)) { }
 
@@ -542,6 +582,37 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
     }
 
     static DRJIT_INLINE Derived zero_(size_t) { return _mm512_setzero_pd(); }
+
+    template <size_t N>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        if constexpr (N >= 2 && N <= 4) {
+            constexpr auto &t = detail::aos_tables<uint64_t, 8, N>;
+            __m512d r[N];
+            for (size_t k = 0; k < N; ++k)
+                r[k] = _mm512_loadu_pd((const double *) ptr + 8 * k);
+            for (size_t j = 0; j < N; ++j)
+                out[j] = detail::mm512_permute_aos_pd<N>(
+                    r, t.load_idx[j], (__mmask8) t.load_sel[j]);
+        } else {
+            Base::template load_aos_<N>(ptr, out);
+        }
+    }
+
+    template <size_t N>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        if constexpr (N >= 2 && N <= 4) {
+            constexpr auto &t = detail::aos_tables<uint64_t, 8, N>;
+            __m512d r[N];
+            for (size_t j = 0; j < N; ++j)
+                r[j] = in[j].m;
+            for (size_t k = 0; k < N; ++k)
+                _mm512_storeu_pd((double *) ptr + 8 * k,
+                                 detail::mm512_permute_aos_pd<N>(
+                                     r, t.store_idx[k], (__mmask8) t.store_sel[k]));
+        } else {
+            Base::template store_aos_<N>(ptr, in);
+        }
+    }
     static DRJIT_INLINE Derived empty_(size_t) { return _mm512_undefined_pd(); }
 
     template <typename Index, typename Mask>
@@ -560,6 +631,17 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
             _mm512_mask_i64scatter_pd(ptr, mask.k, index.m, m, 8);
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        _mm512_mask_compressstoreu_pd(ptr, mask.k, m);
+        return (size_t) _mm_popcnt_u32((unsigned int) mask.k);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        return _mm512_maskz_expandloadu_pd(mask.k, ptr);
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -822,6 +904,17 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
         return (Value) _mm_cvtsi128_si32(_mm512_castsi512_si128(_mm512_maskz_compress_epi32(mask.k, m)));
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        _mm512_mask_compressstoreu_epi32(ptr, mask.k, m);
+        return (size_t) _mm_popcnt_u32((unsigned int) mask.k);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        return _mm512_maskz_expandloadu_epi32(mask.k, ptr);
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -1090,6 +1183,17 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
         return (Value) _mm_cvtsi128_si64(_mm512_castsi512_si128(_mm512_maskz_compress_epi64(mask.k, m)));
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        _mm512_mask_compressstoreu_epi64(ptr, mask.k, m);
+        return (size_t) _mm_popcnt_u32((unsigned int) mask.k);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        return _mm512_maskz_expandloadu_epi64(mask.k, ptr);
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -1127,4 +1231,253 @@ DRJIT_DECLARE_KMASK(Value_, 16, Derived_, enable_if_int32_t<Value_>)
 template <typename Value_, typename Derived_>
 DRJIT_DECLARE_KMASK(Value_, 8, Derived_, enable_if_int64_t<Value_>)
 
+NAMESPACE_BEGIN(detail)
+template <> struct vectorize_half<half, 16> { static constexpr bool self = true; };
+NAMESPACE_END(detail)
+
+/**
+ * \brief Partial overload of StaticArrayImpl using AVX512 intrinsics (half
+ * precision)
+ *
+ * Stores 16 half precision values in a 256-bit register and evaluates
+ * arithmetic in single precision using 512-bit instructions, or natively when
+ * AVX512-FP16 is available.
+ */
+template <bool IsMask_, typename Derived_> struct alignas(32)
+    StaticArrayImpl<half, 16, IsMask_, Derived_, enable_if_t<!IsMask_>>
+  : StaticArrayBase<half, 16, IsMask_, Derived_> {
+    DRJIT_PACKET_TYPE(half, 16, __m256i)
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Value constructors
+    // -----------------------------------------------------------------------
+
+    template <typename T, enable_if_scalar_t<T> = 0>
+    DRJIT_INLINE StaticArrayImpl(T value)
+        : m(_mm256_set1_epi16(memcpy_cast<short>(half((float) value)))) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Type converting constructors
+    // -----------------------------------------------------------------------
+
+    DRJIT_CONVERT(half) : m(a.derived().m) { }
+
+    DRJIT_CONVERT(float) : m(detail::mm512_cvtps_ph(a.derived().m)) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Reinterpreting constructors, mask converters
+    // -----------------------------------------------------------------------
+
+    DRJIT_REINTERPRET(half) : m(a.derived().m) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Converting from/to half size vectors
+    // -----------------------------------------------------------------------
+
+    StaticArrayImpl(const Array1 &a1, const Array2 &a2)
+        : m(detail::concat(a1.m, a2.m)) { }
+
+    DRJIT_INLINE Array1 low_()  const { return _mm256_castsi256_si128(m); }
+    DRJIT_INLINE Array2 high_() const { return _mm256_extracti128_si256(m, 1); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Vertical operations
+    // -----------------------------------------------------------------------
+
+#if defined(DRJIT_X86_AVX512FP16)
+    #define DRJIT_HALF_OP(name, op)                                            \
+        DRJIT_INLINE Derived name##_(Ref a) const {                            \
+            return _mm256_castph_si256(_mm256_##op##_ph(                       \
+                _mm256_castsi256_ph(m), _mm256_castsi256_ph(a.m)));            \
+        }
+
+    #define DRJIT_HALF_FMA(name)                                               \
+        DRJIT_INLINE Derived name##_(Ref b, Ref c) const {                     \
+            return _mm256_castph_si256(_mm256_##name##_ph(                     \
+                _mm256_castsi256_ph(m), _mm256_castsi256_ph(b.m),              \
+                _mm256_castsi256_ph(c.m)));                                    \
+        }
+#else
+    #define DRJIT_HALF_OP(name, op)                                            \
+        DRJIT_INLINE Derived name##_(Ref a) const {                            \
+            return detail::mm512_cvtps_ph(_mm512_##op##_ps(                    \
+                _mm512_cvtph_ps(m), _mm512_cvtph_ps(a.m)));                    \
+        }
+
+    #define DRJIT_HALF_FMA(name)                                               \
+        DRJIT_INLINE Derived name##_(Ref b, Ref c) const {                     \
+            return detail::mm512_cvtps_ph(_mm512_##name##_ps(                  \
+                _mm512_cvtph_ps(m), _mm512_cvtph_ps(b.m),                      \
+                _mm512_cvtph_ps(c.m)));                                        \
+        }
+#endif
+
+    DRJIT_HALF_OP(add, add)
+    DRJIT_HALF_OP(sub, sub)
+    DRJIT_HALF_OP(mul, mul)
+    DRJIT_HALF_OP(div, div)
+    DRJIT_HALF_OP(minimum, min)
+    DRJIT_HALF_OP(maximum, max)
+
+    DRJIT_HALF_FMA(fmadd)
+    DRJIT_HALF_FMA(fmsub)
+    DRJIT_HALF_FMA(fnmadd)
+    DRJIT_HALF_FMA(fnmsub)
+
+    #undef DRJIT_HALF_OP
+    #undef DRJIT_HALF_FMA
+
+    DRJIT_INLINE Derived sqrt_() const {
+        #if defined(DRJIT_X86_AVX512FP16)
+            return _mm256_castph_si256(_mm256_sqrt_ph(_mm256_castsi256_ph(m)));
+        #else
+            return detail::mm512_cvtps_ph(_mm512_sqrt_ps(_mm512_cvtph_ps(m)));
+        #endif
+    }
+
+    DRJIT_INLINE Derived rcp_() const {
+        return detail::mm512_cvtps_ph(
+            _mm512_div_ps(_mm512_set1_ps(1.f), _mm512_cvtph_ps(m)));
+    }
+
+    DRJIT_INLINE Derived rsqrt_() const {
+        return detail::mm512_cvtps_ph(_mm512_div_ps(
+            _mm512_set1_ps(1.f), _mm512_sqrt_ps(_mm512_cvtph_ps(m))));
+    }
+
+    #define DRJIT_HALF_ROUND(name, mode)                                       \
+        DRJIT_INLINE Derived name##_() const {                                 \
+            return detail::mm512_cvtps_ph(_mm512_roundscale_ps(                \
+                _mm512_cvtph_ps(m), mode | _MM_FROUND_NO_EXC));                \
+        }
+
+    DRJIT_HALF_ROUND(floor, _MM_FROUND_TO_NEG_INF)
+    DRJIT_HALF_ROUND(ceil, _MM_FROUND_TO_POS_INF)
+    DRJIT_HALF_ROUND(round, _MM_FROUND_TO_NEAREST_INT)
+    DRJIT_HALF_ROUND(trunc, _MM_FROUND_TO_ZERO)
+
+    #undef DRJIT_HALF_ROUND
+
+    DRJIT_INLINE Derived neg_() const {
+        return _mm256_xor_si256(m, _mm256_set1_epi16((short) 0x8000));
+    }
+
+    DRJIT_INLINE Derived abs_() const {
+        return _mm256_andnot_si256(_mm256_set1_epi16((short) 0x8000), m);
+    }
+
+    DRJIT_INLINE Derived not_() const {
+        return _mm256_ternarylogic_epi32(m, m, m, 0b01010101);
+    }
+
+    template <typename T> DRJIT_INLINE Derived or_(const T &a) const {
+        if constexpr (is_mask_v<T>)
+            return _mm256_mask_mov_epi16(m, a.k, _mm256_set1_epi32(-1));
+        else
+            return _mm256_or_si256(m, a.m);
+    }
+
+    template <typename T> DRJIT_INLINE Derived and_(const T &a) const {
+        if constexpr (is_mask_v<T>)
+            return _mm256_maskz_mov_epi16(a.k, m);
+        else
+            return _mm256_and_si256(m, a.m);
+    }
+
+    template <typename T> DRJIT_INLINE Derived andnot_(const T &a) const {
+        if constexpr (is_mask_v<T>)
+            return _mm256_mask_mov_epi16(m, a.k, _mm256_setzero_si256());
+        else
+            return _mm256_andnot_si256(a.m, m);
+    }
+
+    template <typename T> DRJIT_INLINE Derived xor_(const T &a) const {
+        if constexpr (is_mask_v<T>)
+            return _mm256_xor_si256(m, _mm256_movm_epi16(a.k));
+        else
+            return _mm256_xor_si256(m, a.m);
+    }
+
+    #if defined(DRJIT_X86_AVX512FP16)
+        #define DRJIT_COMP(name, NAME) mask_t<Derived>::from_k(_mm256_cmp_ph_mask(_mm256_castsi256_ph(m), _mm256_castsi256_ph(a.m), _CMP_##NAME))
+    #else
+        #define DRJIT_COMP(name, NAME) mask_t<Derived>::from_k(_mm512_cmp_ps_mask(_mm512_cvtph_ps(m), _mm512_cvtph_ps(a.m), _CMP_##NAME))
+    #endif
+
+    DRJIT_INLINE auto lt_ (Ref a) const { return DRJIT_COMP(lt,  LT_OQ);  }
+    DRJIT_INLINE auto gt_ (Ref a) const { return DRJIT_COMP(gt,  GT_OQ);  }
+    DRJIT_INLINE auto le_ (Ref a) const { return DRJIT_COMP(le,  LE_OQ);  }
+    DRJIT_INLINE auto ge_ (Ref a) const { return DRJIT_COMP(ge,  GE_OQ);  }
+    DRJIT_INLINE auto eq_ (Ref a) const { return DRJIT_COMP(eq,  EQ_OQ);  }
+    DRJIT_INLINE auto neq_(Ref a) const { return DRJIT_COMP(neq, NEQ_UQ); }
+
+    #undef DRJIT_COMP
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived select_(const Mask &m, Ref t, Ref f) {
+        return _mm256_mask_blend_epi16(m.k, f.m, t.m);
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Horizontal operations
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE Value sum_()  const { return Value(_mm512_reduce_add_ps(_mm512_cvtph_ps(m))); }
+    DRJIT_INLINE Value prod_() const { return Value(_mm512_reduce_mul_ps(_mm512_cvtph_ps(m))); }
+    DRJIT_INLINE Value min_()  const { return Value(_mm512_reduce_min_ps(_mm512_cvtph_ps(m))); }
+    DRJIT_INLINE Value max_()  const { return Value(_mm512_reduce_max_ps(_mm512_cvtph_ps(m))); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Initialization, loading/writing data
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE void store_aligned_(void *ptr) const {
+        _mm256_store_si256((__m256i *) DRJIT_ASSUME_ALIGNED(ptr, 32), m);
+    }
+
+    DRJIT_INLINE void store_(void *ptr) const {
+        _mm256_storeu_si256((__m256i *) ptr, m);
+    }
+
+    static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
+        return _mm256_load_si256((const __m256i *) DRJIT_ASSUME_ALIGNED(ptr, 32));
+    }
+
+    static DRJIT_INLINE Derived load_(const void *ptr, size_t) {
+        return _mm256_loadu_si256((const __m256i *) ptr);
+    }
+
+    static DRJIT_INLINE Derived empty_(size_t) { return _mm256_undefined_si256(); }
+    static DRJIT_INLINE Derived zero_(size_t) { return _mm256_setzero_si256(); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+} DRJIT_MAY_ALIAS;
+
+/// Masks of half precision packets use the single precision representation
+template <bool IsMask_, typename Derived_>
+struct StaticArrayImpl<half, 16, IsMask_, Derived_, enable_if_t<IsMask_>>
+  : StaticArrayImpl<float, 16, IsMask_, Derived_> {
+    using Base = StaticArrayImpl<float, 16, IsMask_, Derived_>;
+    DRJIT_ARRAY_IMPORT(StaticArrayImpl, Base)
+};
+
 NAMESPACE_END(drjit)
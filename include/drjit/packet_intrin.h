@@ -15,6 +15,15 @@
 
 #include <drjit-core/intrin.h>
 
+// Native half precision arithmetic (not detected by drjit-core)
+#if defined(DRJIT_X86_AVX512) && defined(__AVX512FP16__)
+#  define DRJIT_X86_AVX512FP16 1
+#endif
+
+#if defined(DRJIT_ARM_64) && defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+#  define DRJIT_ARM_FP16 1
+#endif
+
 // -----------------------------------------------------------------------
 //! @{ \name Available instruction sets
 // -----------------------------------------------------------------------
@@ -97,6 +106,18 @@
     static constexpr bool has_neon = false;
 #endif
 
+#if defined(DRJIT_X86_AVX512FP16)
+    static constexpr bool has_avx512fp16 = true;
+#else
+    static constexpr bool has_avx512fp16 = false;
+#endif
+
+#if defined(DRJIT_ARM_FP16)
+    static constexpr bool has_arm_fp16 = true;
+#else
+    static constexpr bool has_arm_fp16 = false;
+#endif
+
 static constexpr bool has_x86 = has_x86_32 || has_x86_64;
 static constexpr bool has_arm = has_arm_32 || has_arm_64;
 static constexpr bool has_vectorization = has_sse42 || has_neon;
@@ -245,6 +266,206 @@ template <typename T> DRJIT_INLINE T tzcnt(T v) {
 //! @}
 // -----------------------------------------------------------------------
 
+// -----------------------------------------------------------------------
+//! @{ \name Half precision conversion routines
+// -----------------------------------------------------------------------
+
+#if defined(DRJIT_X86_F16C)
+DRJIT_INLINE __m128i mm256_cvtps_ph(__m256 x) {
+    return _mm256_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+/// Narrow a mask with 32-bit lanes into a mask with 16-bit lanes
+DRJIT_INLINE __m128i mm256_cvtmask_epi16(__m256 x) {
+    __m256i xi = _mm256_castps_si256(x);
+    return _mm_packs_epi32(_mm256_castsi256_si128(xi),
+                           _mm256_extractf128_si256(xi, 1));
+}
+#endif
+
+#if defined(DRJIT_X86_AVX512)
+DRJIT_INLINE __m256i mm512_cvtps_ph(__m512 x) {
+    return _mm512_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+#endif
+
+//! @}
+// -----------------------------------------------------------------------
+
+// -----------------------------------------------------------------------
+//! @{ \name Permutation tables for compress_store() and expand_load()
+// -----------------------------------------------------------------------
+
+/**
+ * \brief Lookup tables mapping an 8-bit (or 4-bit) lane mask to the lane
+ * permutation that packs/unpacks the active entries.
+ *
+ * Each entry stores eight 4-bit lane indices (nibble \c i refers to lane \c
+ * i). The \c compress table lists the source lane of each packed output
+ * entry, while the \c expand table holds the number of active lanes
+ * preceding each lane. The \c *64 variants address 64-bit lanes as pairs of
+ * 32-bit lanes.
+ */
+struct CompressTables {
+    uint32_t compress[256], expand[256];
+    uint32_t compress64[16], expand64[16];
+
+    constexpr CompressTables()
+        : compress(), expand(), compress64(), expand64() {
+        for (uint32_t mask = 0; mask < 256; ++mask) {
+            uint32_t k = 0;
+            for (uint32_t i = 0; i < 8; ++i) {
+                if (!(mask & (1u << i)))
+                    continue;
+
+                compress[mask] |= i << (4 * k);
+                expand[mask] |= k << (4 * i);
+
+                if (mask < 16) {
+                    compress64[mask] |= ((2 * i) << (8 * k)) |
+                                        ((2 * i + 1) << (8 * k + 4));
+                    expand64[mask] |= ((2 * k) << (8 * i)) |
+                                      ((2 * k + 1) << (8 * i + 4));
+                }
+
+                k++;
+            }
+        }
+    }
+};
+
+inline constexpr CompressTables compress_tables{};
+
+#if defined(DRJIT_X86_AVX2)
+/// Unpack a nibble-encoded permutation from 'CompressTables' into lanes
+DRJIT_INLINE __m256i mm256_decode_perm_epi32(uint32_t entry) {
+    const __m256i shift = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+    return _mm256_and_si256(
+        _mm256_srlv_epi32(_mm256_set1_epi32((int) entry), shift),
+        _mm256_set1_epi32(0xF));
+}
+
+/// Return a mask enabling the first 'n' 32-bit lanes
+DRJIT_INLINE __m256i mm256_prefix_mask_epi32(uint32_t n) {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32((int) n),
+                              _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+/// Convert an 8-bit lane mask into a vector mask with 32-bit lanes
+DRJIT_INLINE __m256i mm256_movemask_inv_epi32(uint32_t bits) {
+    const __m256i bit = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(
+        _mm256_and_si256(_mm256_set1_epi32((int) bits), bit), bit);
+}
+
+/// Convert a 4-bit lane mask into a vector mask with 64-bit lanes
+DRJIT_INLINE __m256i mm256_movemask_inv_epi64(uint32_t bits) {
+    const __m256i bit = _mm256_setr_epi32(1, 1, 2, 2, 4, 4, 8, 8);
+    return _mm256_cmpeq_epi32(
+        _mm256_and_si256(_mm256_set1_epi32((int) bits), bit), bit);
+}
+#endif
+
+//! @}
+// -----------------------------------------------------------------------
+
+// -----------------------------------------------------------------------
+//! @{ \name Permutation tables for load_aos() and store_aos()
+// -----------------------------------------------------------------------
+
+/**
+ * \brief Index vectors that convert between \c N interleaved registers
+ * (array of structures) and \c N component registers (structure of arrays)
+ * with \c L lanes each.
+ *
+ * Output lane \c q is taken from lane \c b of source register \c a. Sources
+ * 0/1 and 2/3 are combined by two-register permutes using the index
+ * <tt>(a & 1) * L + b</tt>, and bit \c q of the \c *_sel masks is set when
+ * lane \c q must instead come from source 2 or 3.
+ */
+template <typename Index, size_t L, size_t N> struct AosTables {
+    Index load_idx[N][L], store_idx[N][L];
+    uint32_t load_sel[N], store_sel[N];
+
+    constexpr AosTables()
+        : load_idx(), store_idx(), load_sel(), store_sel() {
+        for (size_t j = 0; j < N; ++j) {
+            for (size_t q = 0; q < L; ++q) {
+                // Component 'j' of record 'q' is at offset 'q*N + j'
+                size_t s = q * N + j, a = s / L, b = s % L;
+                load_idx[j][q] = (Index) ((a & 1) * L + b);
+                if (a >= 2)
+                    load_sel[j] |= 1u << q;
+
+                // Offset 'j*L + q' holds component 'p % N' of record 'p / N'
+                size_t p = j * L + q;
+                a = p % N;
+                b = p / N;
+                store_idx[j][q] = (Index) ((a & 1) * L + b);
+                if (a >= 2)
+                    store_sel[j] |= 1u << q;
+            }
+        }
+    }
+};
+
+template <typename Index, size_t L, size_t N>
+inline constexpr AosTables<Index, L, N> aos_tables{};
+
+#if defined(DRJIT_X86_AVX512)
+/// Combine up to four registers using an index vector from 'AosTables'
+template <size_t N>
+DRJIT_INLINE __m512 mm512_permute_aos_ps(const __m512 *r, const void *idx,
+                                         __mmask16 sel) {
+    __m512i i = _mm512_loadu_si512(idx);
+    __m512 t = _mm512_permutex2var_ps(r[0], i, r[1]);
+    if constexpr (N == 3)
+        t = _mm512_mask_permutexvar_ps(t, sel, i, r[2]);
+    else if constexpr (N == 4)
+        t = _mm512_mask_blend_ps(sel, t, _mm512_permutex2var_ps(r[2], i, r[3]));
+    return t;
+}
+
+template <size_t N>
+DRJIT_INLINE __m512d mm512_permute_aos_pd(const __m512d *r, const void *idx,
+                                          __mmask8 sel) {
+    __m512i i = _mm512_loadu_si512(idx);
+    __m512d t = _mm512_permutex2var_pd(r[0], i, r[1]);
+    if constexpr (N == 3)
+        t = _mm512_mask_permutexvar_pd(t, sel, i, r[2]);
+    else if constexpr (N == 4)
+        t = _mm512_mask_blend_pd(sel, t, _mm512_permutex2var_pd(r[2], i, r[3]));
+    return t;
+}
+#endif
+
+#if defined(DRJIT_X86_AVX)
+/// Load two (unaligned) 128-bit halves into a 256-bit register
+DRJIT_INLINE __m256 mm256_loadu2_ps(const float *lo, const float *hi) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)),
+                                _mm_loadu_ps(hi), 1);
+}
+
+DRJIT_INLINE __m256d mm256_loadu2_pd(const double *lo, const double *hi) {
+    return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(lo)),
+                                _mm_loadu_pd(hi), 1);
+}
+
+/// Store the two 128-bit halves of a 256-bit register to separate addresses
+DRJIT_INLINE void mm256_storeu2_ps(float *lo, float *hi, __m256 v) {
+    _mm_storeu_ps(lo, _mm256_castps256_ps128(v));
+    _mm_storeu_ps(hi, _mm256_extractf128_ps(v, 1));
+}
+
+DRJIT_INLINE void mm256_storeu2_pd(double *lo, double *hi, __m256d v) {
+    _mm_storeu_pd(lo, _mm256_castpd256_pd128(v));
+    _mm_storeu_pd(hi, _mm256_extractf128_pd(v, 1));
+}
+#endif
+
+//! @}
+// -----------------------------------------------------------------------
+
 #define DRJIT_PACKET_DECLARE(Size)                                             \
     namespace detail {                                                         \
         template <typename Type> struct vectorize<Type, Size> {                \
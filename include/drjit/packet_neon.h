@@ -27,6 +27,44 @@ static constexpr uint64_t arm_shuffle_helper_(int i) {
     else
         return 0x0F0E0D0C;
 }
+
+#if defined(DRJIT_ARM_64)
+/// Byte shuffle tables (for 'vqtbl1q_u8') used by compress_store()/expand_load()
+struct NeonCompressTables {
+    uint8_t compress[16][16], expand[16][16], count[16];
+
+    constexpr NeonCompressTables() : compress(), expand(), count() {
+        for (uint32_t mask = 0; mask < 16; ++mask) {
+            uint32_t k = 0;
+            for (uint32_t i = 0; i < 4; ++i) {
+                for (uint32_t j = 0; j < 4; ++j)
+                    expand[mask][4 * i + j] = 0xFF; // out of range -> zero
+
+                if (!(mask & (1u << i)))
+                    continue;
+
+                for (uint32_t j = 0; j < 4; ++j) {
+                    compress[mask][4 * k + j] = (uint8_t) (4 * i + j);
+                    expand[mask][4 * i + j] = (uint8_t) (4 * k + j);
+                }
+                k++;
+            }
+            count[mask] = (uint8_t) k;
+        }
+    }
+};
+
+inline constexpr NeonCompressTables neon_compress_tables{};
+
+DRJIT_INLINE uint32_t neon_bitmask(uint32x4_t m) {
+    const uint32x4_t bit = { 1, 2, 4, 8 };
+    return vaddvq_u32(vandq_u32(m, bit));
+}
+
+DRJIT_INLINE uint32_t neon_bitmask(float32x4_t m) {
+    return neon_bitmask(vreinterpretq_u32_f32(m));
+}
+#endif
 NAMESPACE_END(detail)
 
 DRJIT_INLINE uint64x2_t vmvnq_u64(uint64x2_t a) {
@@ -63,8 +101,8 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
     DRJIT_CONVERT(float) : m(a.derived().m) {}
     DRJIT_CONVERT(int32_t) : m(vcvtq_f32_s32(vreinterpretq_s32_u32(a.derived().m))) {}
     DRJIT_CONVERT(uint32_t) : m(vcvtq_f32_u32(a.derived().m)) {}
-    // DRJIT_CONVERT(half) : m(vcvt_f32_f16(vld1_f16((const __fp16 *)a.data()))) {}
 #if defined(DRJIT_ARM_64)
+    DRJIT_CONVERT(half) : m(vcvt_f32_f16(vld1_f16((const __fp16 *) a.derived().data()))) {}
     DRJIT_CONVERT(double) : m(vcvtx_high_f32_f64(vcvtx_f32_f64(low(a).m), high(a).m)) {}
 #endif
 
@@ -327,6 +365,70 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
 
     static DRJIT_INLINE Derived zero_(size_t) { return vdupq_n_f32(0.f); }
 
+    /* NEON natively (de-)interleaves structures of 2-4 components */
+    template <size_t N>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        const float *p = (const float *) ptr;
+        if constexpr (Derived::Size == 4 && N == 2) {
+            float32x4x2_t v = vld2q_f32(p);
+            out[0] = v.val[0]; out[1] = v.val[1];
+        } else if constexpr (Derived::Size == 4 && N == 3) {
+            float32x4x3_t v = vld3q_f32(p);
+            out[0] = v.val[0]; out[1] = v.val[1]; out[2] = v.val[2];
+        } else if constexpr (Derived::Size == 4 && N == 4) {
+            float32x4x4_t v = vld4q_f32(p);
+            out[0] = v.val[0]; out[1] = v.val[1];
+            out[2] = v.val[2]; out[3] = v.val[3];
+        } else {
+            Base::template load_aos_<N>(ptr, out);
+        }
+    }
+
+    template <size_t N>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        float *p = (float *) ptr;
+        if constexpr (Derived::Size == 4 && N == 2) {
+            vst2q_f32(p, float32x4x2_t{ { in[0].m, in[1].m } });
+        } else if constexpr (Derived::Size == 4 && N == 3) {
+            vst3q_f32(p, float32x4x3_t{ { in[0].m, in[1].m, in[2].m } });
+        } else if constexpr (Derived::Size == 4 && N == 4) {
+            vst4q_f32(p, float32x4x4_t{ { in[0].m, in[1].m, in[2].m, in[3].m } });
+        } else {
+            Base::template store_aos_<N>(ptr, in);
+        }
+    }
+
+#if defined(DRJIT_ARM_64)
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        if constexpr (Derived::Size == 4) {
+            uint32_t bits = detail::neon_bitmask(mask.m);
+            size_t count = detail::neon_compress_tables.count[bits];
+            uint8x16_t perm = vld1q_u8(detail::neon_compress_tables.compress[bits]);
+            alignas(16) Value tmp[4];
+            vst1q_f32((float *) tmp, vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(m), perm)));
+            memcpy(ptr, tmp, count * sizeof(Value));
+            return count;
+        } else {
+            return Base::compress_store_(ptr, mask);
+        }
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        if constexpr (Derived::Size == 4) {
+            uint32_t bits = detail::neon_bitmask(mask.m);
+            size_t count = detail::neon_compress_tables.count[bits];
+            uint8x16_t perm = vld1q_u8(detail::neon_compress_tables.expand[bits]);
+            alignas(16) Value tmp[4] { };
+            memcpy(tmp, ptr, count * sizeof(Value));
+            return vreinterpretq_f32_u8(vqtbl1q_u8(vreinterpretq_u8_f32(vld1q_f32((const float *) tmp)), perm));
+        } else {
+            return Base::expand_load_(ptr, mask);
+        }
+    }
+#endif
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -523,6 +625,37 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
 
     static DRJIT_INLINE Derived zero_(size_t) { return vdupq_n_f64(0.0); }
 
+    template <size_t N>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        const double *p = (const double *) ptr;
+        if constexpr (N == 2) {
+            float64x2x2_t v = vld2q_f64(p);
+            out[0] = v.val[0]; out[1] = v.val[1];
+        } else if constexpr (N == 3) {
+            float64x2x3_t v = vld3q_f64(p);
+            out[0] = v.val[0]; out[1] = v.val[1]; out[2] = v.val[2];
+        } else if constexpr (N == 4) {
+            float64x2x4_t v = vld4q_f64(p);
+            out[0] = v.val[0]; out[1] = v.val[1];
+            out[2] = v.val[2]; out[3] = v.val[3];
+        } else {
+            Base::template load_aos_<N>(ptr, out);
+        }
+    }
+
+    template <size_t N>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        double *p = (double *) ptr;
+        if constexpr (N == 2)
+            vst2q_f64(p, float64x2x2_t{ { in[0].m, in[1].m } });
+        else if constexpr (N == 3)
+            vst3q_f64(p, float64x2x3_t{ { in[0].m, in[1].m, in[2].m } });
+        else if constexpr (N == 4)
+            vst4q_f64(p, float64x2x4_t{ { in[0].m, in[1].m, in[2].m, in[3].m } });
+        else
+            Base::template store_aos_<N>(ptr, in);
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -882,6 +1015,37 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(16)
 
     static DRJIT_INLINE Derived zero_(size_t) { return vdupq_n_u32(0); }
 
+#if defined(DRJIT_ARM_64)
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        if constexpr (Derived::Size == 4) {
+            uint32_t bits = detail::neon_bitmask(mask.m);
+            size_t count = detail::neon_compress_tables.count[bits];
+            uint8x16_t perm = vld1q_u8(detail::neon_compress_tables.compress[bits]);
+            alignas(16) Value tmp[4];
+            vst1q_u32((uint32_t *) tmp, vreinterpretq_u32_u8(vqtbl1q_u8(vreinterpretq_u8_u32(m), perm)));
+            memcpy(ptr, tmp, count * sizeof(Value));
+            return count;
+        } else {
+            return Base::compress_store_(ptr, mask);
+        }
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        if constexpr (Derived::Size == 4) {
+            uint32_t bits = detail::neon_bitmask(mask.m);
+            size_t count = detail::neon_compress_tables.count[bits];
+            uint8x16_t perm = vld1q_u8(detail::neon_compress_tables.expand[bits]);
+            alignas(16) Value tmp[4] { };
+            memcpy(tmp, ptr, count * sizeof(Value));
+            return vreinterpretq_u32_u8(vqtbl1q_u8(vreinterpretq_u8_u32(vld1q_u32((const uint32_t *) tmp)), perm));
+        } else {
+            return Base::expand_load_(ptr, mask);
+        }
+    }
+#endif
+
     //! @}
     // -----------------------------------------------------------------------
 };
@@ -1254,4 +1418,282 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(16)
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
 
+#if defined(DRJIT_ARM_64)
+NAMESPACE_BEGIN(detail)
+template <> struct vectorize_half<half, 8> { static constexpr bool self = true; };
+
+DRJIT_INLINE float32x4_t neon_cvt_low_f32(uint16x8_t a) {
+    return vcvt_f32_f16(vget_low_f16(vreinterpretq_f16_u16(a)));
+}
+
+DRJIT_INLINE float32x4_t neon_cvt_high_f32(uint16x8_t a) {
+    return vcvt_high_f32_f16(vreinterpretq_f16_u16(a));
+}
+
+DRJIT_INLINE uint16x8_t neon_cvt_f16(float32x4_t lo, float32x4_t hi) {
+    return vreinterpretq_u16_f16(vcvt_high_f16_f32(vcvt_f16_f32(lo), hi));
+}
+
+/// Narrow a pair of masks with 32-bit lanes into a mask with 16-bit lanes
+DRJIT_INLINE uint16x8_t neon_cvtmask_u16(float32x4_t lo, float32x4_t hi) {
+    return vcombine_u16(vmovn_u32(vreinterpretq_u32_f32(lo)),
+                        vmovn_u32(vreinterpretq_u32_f32(hi)));
+}
+NAMESPACE_END(detail)
+
+/**
+ * \brief Partial overload of StaticArrayImpl using ARM NEON intrinsics (half
+ * precision)
+ *
+ * Stores eight half precision values in a 128-bit register. Arithmetic uses
+ * the native FP16 instructions when available (ARMv8.2-A), and otherwise
+ * converts both halves to single precision and rounds the result back.
+ */
+template <bool IsMask_, typename Derived_> struct alignas(16)
+    StaticArrayImpl<half, 8, IsMask_, Derived_, enable_if_t<!IsMask_>>
+  : StaticArrayBase<half, 8, IsMask_, Derived_> {
+    DRJIT_PACKET_TYPE(half, 8, uint16x8_t)
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Value constructors
+    // -----------------------------------------------------------------------
+
+    template <typename T, enable_if_scalar_t<T> = 0>
+    DRJIT_INLINE StaticArrayImpl(T value)
+        : m(vdupq_n_u16(memcpy_cast<uint16_t>(half((float) value)))) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Type converting constructors
+    // -----------------------------------------------------------------------
+
+    DRJIT_CONVERT(half) : m(a.derived().m) { }
+
+    DRJIT_CONVERT(float) : m(detail::neon_cvt_f16(low(a).m, high(a).m)) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Reinterpreting constructors, mask converters
+    // -----------------------------------------------------------------------
+
+    DRJIT_REINTERPRET(half) : m(a.derived().m) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Converting from/to half size vectors
+    // -----------------------------------------------------------------------
+
+    StaticArrayImpl(const Array1 &a1, const Array2 &a2)
+        : m(vcombine_u16(vld1_u16((const uint16_t *) a1.data()),
+                         vld1_u16((const uint16_t *) a2.data()))) { }
+
+    DRJIT_INLINE Array1 low_()  const { return Array1(entry(0), entry(1), entry(2), entry(3)); }
+    DRJIT_INLINE Array2 high_() const { return Array2(entry(4), entry(5), entry(6), entry(7)); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Vertical operations
+    // -----------------------------------------------------------------------
+
+#if defined(DRJIT_ARM_FP16)
+    #define DRJIT_HALF_OP(name, op)                                            \
+        DRJIT_INLINE Derived name##_(Ref a) const {                            \
+            return vreinterpretq_u16_f16(v##op##q_f16(                         \
+                vreinterpretq_f16_u16(m), vreinterpretq_f16_u16(a.m)));        \
+        }
+#else
+    #define DRJIT_HALF_OP(name, op)                                            \
+        DRJIT_INLINE Derived name##_(Ref a) const {                            \
+            return detail::neon_cvt_f16(                                       \
+                v##op##q_f32(detail::neon_cvt_low_f32(m),                      \
+                             detail::neon_cvt_low_f32(a.m)),                   \
+                v##op##q_f32(detail::neon_cvt_high_f32(m),                     \
+                             detail::neon_cvt_high_f32(a.m)));                 \
+        }
+#endif
+
+    DRJIT_HALF_OP(add, add)
+    DRJIT_HALF_OP(sub, sub)
+    DRJIT_HALF_OP(mul, mul)
+    DRJIT_HALF_OP(div, div)
+    DRJIT_HALF_OP(minimum, min)
+    DRJIT_HALF_OP(maximum, max)
+
+    #undef DRJIT_HALF_OP
+
+    /* Fused multiply-add variants: 'op' is vfma/vfms, which compute c +/- a*b,
+       and 'neg' flips the sign of the addend */
+#if defined(DRJIT_ARM_FP16)
+    #define DRJIT_HALF_FMA(name, op, neg)                                      \
+        DRJIT_INLINE Derived name##_(Ref b, Ref c) const {                     \
+            uint16x8_t c2 = veorq_u16(c.m, vdupq_n_u16(neg ? 0x8000 : 0));     \
+            return vreinterpretq_u16_f16(op##q_f16(                            \
+                vreinterpretq_f16_u16(c2), vreinterpretq_f16_u16(m),           \
+                vreinterpretq_f16_u16(b.m)));                                  \
+        }
+#else
+    #define DRJIT_HALF_FMA(name, op, neg)                                      \
+        DRJIT_INLINE Derived name##_(Ref b, Ref c) const {                     \
+            uint16x8_t c2 = veorq_u16(c.m, vdupq_n_u16(neg ? 0x8000 : 0));     \
+            return detail::neon_cvt_f16(                                       \
+                op##q_f32(detail::neon_cvt_low_f32(c2),                        \
+                          detail::neon_cvt_low_f32(m),                         \
+                          detail::neon_cvt_low_f32(b.m)),                      \
+                op##q_f32(detail::neon_cvt_high_f32(c2),                       \
+                          detail::neon_cvt_high_f32(m),                        \
+                          detail::neon_cvt_high_f32(b.m)));                    \
+        }
+#endif
+
+    DRJIT_HALF_FMA(fmadd,  vfma, false)
+    DRJIT_HALF_FMA(fnmadd, vfms, false)
+    DRJIT_HALF_FMA(fmsub,  vfma, true)
+    DRJIT_HALF_FMA(fnmsub, vfms, true)
+
+    #undef DRJIT_HALF_FMA
+
+    #define DRJIT_HALF_UNARY(name, op)                                         \
+        DRJIT_INLINE Derived name##_() const {                                 \
+            return detail::neon_cvt_f16(                                       \
+                op(detail::neon_cvt_low_f32(m)),                               \
+                op(detail::neon_cvt_high_f32(m)));                             \
+        }
+
+    DRJIT_HALF_UNARY(round, vrndnq_f32)
+    DRJIT_HALF_UNARY(floor, vrndmq_f32)
+    DRJIT_HALF_UNARY(ceil,  vrndpq_f32)
+    DRJIT_HALF_UNARY(trunc, vrndq_f32)
+
+#if defined(DRJIT_ARM_FP16)
+    DRJIT_INLINE Derived sqrt_() const {
+        return vreinterpretq_u16_f16(vsqrtq_f16(vreinterpretq_f16_u16(m)));
+    }
+#else
+    DRJIT_HALF_UNARY(sqrt, vsqrtq_f32)
+#endif
+
+    #undef DRJIT_HALF_UNARY
+
+    DRJIT_INLINE Derived rcp_() const {
+        const float32x4_t one = vdupq_n_f32(1.f);
+        return detail::neon_cvt_f16(
+            vdivq_f32(one, detail::neon_cvt_low_f32(m)),
+            vdivq_f32(one, detail::neon_cvt_high_f32(m)));
+    }
+
+    DRJIT_INLINE Derived rsqrt_() const {
+        const float32x4_t one = vdupq_n_f32(1.f);
+        return detail::neon_cvt_f16(
+            vdivq_f32(one, vsqrtq_f32(detail::neon_cvt_low_f32(m))),
+            vdivq_f32(one, vsqrtq_f32(detail::neon_cvt_high_f32(m))));
+    }
+
+    DRJIT_INLINE Derived neg_() const { return veorq_u16(m, vdupq_n_u16(0x8000)); }
+    DRJIT_INLINE Derived abs_() const { return vbicq_u16(m, vdupq_n_u16(0x8000)); }
+    DRJIT_INLINE Derived not_() const { return vmvnq_u16(m); }
+
+    template <typename T> DRJIT_INLINE Derived or_ (const T &a) const { return vorrq_u16(m, bits_(a)); }
+    template <typename T> DRJIT_INLINE Derived and_(const T &a) const { return vandq_u16(m, bits_(a)); }
+    template <typename T> DRJIT_INLINE Derived andnot_(const T &a) const { return vbicq_u16(m, bits_(a)); }
+    template <typename T> DRJIT_INLINE Derived xor_(const T &a) const { return veorq_u16(m, bits_(a)); }
+
+    #define DRJIT_COMP(op)                                                     \
+        using Mask1 = typename mask_t<Derived>::Array1;                        \
+        using Mask2 = typename mask_t<Derived>::Array2;                        \
+        return mask_t<Derived>(                                                \
+            Mask1(vreinterpretq_f32_u32(op(detail::neon_cvt_low_f32(m),        \
+                                           detail::neon_cvt_low_f32(a.m)))),   \
+            Mask2(vreinterpretq_f32_u32(op(detail::neon_cvt_high_f32(m),       \
+                                           detail::neon_cvt_high_f32(a.m)))))
+
+    DRJIT_INLINE auto lt_ (Ref a) const { DRJIT_COMP(vcltq_f32); }
+    DRJIT_INLINE auto gt_ (Ref a) const { DRJIT_COMP(vcgtq_f32); }
+    DRJIT_INLINE auto le_ (Ref a) const { DRJIT_COMP(vcleq_f32); }
+    DRJIT_INLINE auto ge_ (Ref a) const { DRJIT_COMP(vcgeq_f32); }
+    DRJIT_INLINE auto eq_ (Ref a) const { DRJIT_COMP(vceqq_f32); }
+    DRJIT_INLINE auto neq_(Ref a) const { return !eq_(a); }
+
+    #undef DRJIT_COMP
+
+    template <typename Mask_>
+    static DRJIT_INLINE Derived select_(const Mask_ &m, Ref t, Ref f) {
+        return vbslq_u16(bits_(m), t.m, f.m);
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Horizontal operations
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE Value sum_() const {
+        return Value(vaddvq_f32(vaddq_f32(detail::neon_cvt_low_f32(m),
+                                          detail::neon_cvt_high_f32(m))));
+    }
+
+    DRJIT_INLINE Value min_() const {
+        return Value(vminvq_f32(vminq_f32(detail::neon_cvt_low_f32(m),
+                                          detail::neon_cvt_high_f32(m))));
+    }
+
+    DRJIT_INLINE Value max_() const {
+        return Value(vmaxvq_f32(vmaxq_f32(detail::neon_cvt_low_f32(m),
+                                          detail::neon_cvt_high_f32(m))));
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Initialization, loading/writing data
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE void store_aligned_(void *ptr) const {
+        vst1q_u16((uint16_t *) DRJIT_ASSUME_ALIGNED(ptr, 16), m);
+    }
+
+    DRJIT_INLINE void store_(void *ptr) const {
+        vst1q_u16((uint16_t *) ptr, m);
+    }
+
+    static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
+        return vld1q_u16((const uint16_t *) DRJIT_ASSUME_ALIGNED(ptr, 16));
+    }
+
+    static DRJIT_INLINE Derived load_(const void *ptr, size_t) {
+        return vld1q_u16((const uint16_t *) ptr);
+    }
+
+    static DRJIT_INLINE Derived zero_(size_t) { return vdupq_n_u16(0); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    /// Bit pattern of a half precision array or mask with 16-bit lanes
+    template <typename T> static DRJIT_INLINE uint16x8_t bits_(const T &a) {
+        if constexpr (is_mask_v<T>)
+            return detail::neon_cvtmask_u16(low(a).m, high(a).m);
+        else
+            return a.m;
+    }
+} DRJIT_MAY_ALIAS;
+
+/// Masks of half precision packets use the single precision representation
+template <bool IsMask_, typename Derived_>
+struct StaticArrayImpl<half, 8, IsMask_, Derived_, enable_if_t<IsMask_>>
+  : StaticArrayImpl<float, 8, IsMask_, Derived_> {
+    using Base = StaticArrayImpl<float, 8, IsMask_, Derived_>;
+    DRJIT_ARRAY_IMPORT(StaticArrayImpl, Base)
+};
+#endif
+
 NAMESPACE_END(drjit)
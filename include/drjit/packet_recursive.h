@@ -332,6 +332,42 @@ struct StaticArrayImpl<Value_, Size_, IsMask_, Derived_,
         scatter(ptr, a2, high(index), high(mask), mode);
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        size_t n = compress_store(ptr, a1, low(mask));
+        return n + compress_store((Scalar *) ptr + n, a2, high(mask));
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        return Derived(
+            expand_load<Array1>(ptr, low(mask)),
+            expand_load<Array2>((const Scalar *) ptr + count(low(mask)), high(mask))
+        );
+    }
+
+    template <size_t N>
+    static DRJIT_INLINE void load_aos_(const void *mem, Derived *out) {
+        Array1 b1[N];
+        Array2 b2[N];
+        Array1::template load_aos_<N>(mem, b1);
+        Array2::template load_aos_<N>((const Scalar *) mem + Size1 * N, b2);
+        for (size_t j = 0; j < N; ++j)
+            out[j] = Derived(b1[j], b2[j]);
+    }
+
+    template <size_t N>
+    static DRJIT_INLINE void store_aos_(void *mem, const Derived *in) {
+        Array1 b1[N];
+        Array2 b2[N];
+        for (size_t j = 0; j < N; ++j) {
+            b1[j] = in[j].a1;
+            b2[j] = in[j].a2;
+        }
+        Array1::template store_aos_<N>(mem, b1);
+        Array2::template store_aos_<N>((Scalar *) mem + Size1 * N, b2);
+    }
+
     static DRJIT_INLINE Derived zero_(size_t) {
         return Derived(zeros<Array1>(), zeros<Array2>());
     }
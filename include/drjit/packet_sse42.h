@@ -40,11 +40,11 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
     //! @{ \name Type converting constructors
     // -----------------------------------------------------------------------
 
-// #if defined(DRJIT_X86_F16C)
-    // DRJIT_CONVERT(half) {
-    //     m = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) a.derived().data()));
-    // }
-// #endif
+#if defined(DRJIT_X86_F16C)
+    DRJIT_CONVERT(half) {
+        m = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) a.derived().data()));
+    }
+#endif
 
     DRJIT_CONVERT(float) : m(a.derived().m) { }
     DRJIT_CONVERT(int32_t) : m(_mm_cvtepi32_ps(a.derived().m)) { }
@@ -397,6 +397,72 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
     static DRJIT_INLINE Derived empty_(size_t) { return _mm_undefined_ps(); }
     static DRJIT_INLINE Derived zero_(size_t) { return _mm_setzero_ps(); }
 
+    template <size_t N>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        const float *p = (const float *) ptr;
+        if constexpr (Derived::Size == 4 && N == 2) {
+            __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4);
+            out[0] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            out[1] = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        } else if constexpr (Derived::Size == 4 && N == 3) {
+            /* a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3). Blend
+               each component into place, then fix the lane order */
+            __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4),
+                   c = _mm_loadu_ps(p + 8);
+
+            __m128 x = _mm_blend_ps(_mm_blend_ps(a, b, 0b0100), c, 0b0010),
+                   y = _mm_blend_ps(_mm_blend_ps(a, b, 0b1001), c, 0b0100),
+                   z = _mm_blend_ps(_mm_blend_ps(a, b, 0b0010), c, 0b1001);
+
+            out[0] = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 2, 3, 0));
+            out[1] = _mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 3, 0, 1));
+            out[2] = _mm_shuffle_ps(z, z, _MM_SHUFFLE(3, 0, 1, 2));
+        } else if constexpr (Derived::Size == 4 && N == 4) {
+            __m128 r0 = _mm_loadu_ps(p),     r1 = _mm_loadu_ps(p + 4),
+                   r2 = _mm_loadu_ps(p + 8), r3 = _mm_loadu_ps(p + 12);
+
+            __m128 t0 = _mm_unpacklo_ps(r0, r1), t1 = _mm_unpacklo_ps(r2, r3),
+                   t2 = _mm_unpackhi_ps(r0, r1), t3 = _mm_unpackhi_ps(r2, r3);
+
+            out[0] = _mm_movelh_ps(t0, t1);
+            out[1] = _mm_movehl_ps(t1, t0);
+            out[2] = _mm_movelh_ps(t2, t3);
+            out[3] = _mm_movehl_ps(t3, t2);
+        } else {
+            Base::template load_aos_<N>(ptr, out);
+        }
+    }
+
+    template <size_t N>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        float *p = (float *) ptr;
+        if constexpr (Derived::Size == 4 && N == 2) {
+            _mm_storeu_ps(p,     _mm_unpacklo_ps(in[0].m, in[1].m));
+            _mm_storeu_ps(p + 4, _mm_unpackhi_ps(in[0].m, in[1].m));
+        } else if constexpr (Derived::Size == 4 && N == 3) {
+            // Inverse of the permutation in load_aos_()
+            __m128 x = _mm_shuffle_ps(in[0].m, in[0].m, _MM_SHUFFLE(1, 2, 3, 0)),
+                   y = _mm_shuffle_ps(in[1].m, in[1].m, _MM_SHUFFLE(2, 3, 0, 1)),
+                   z = _mm_shuffle_ps(in[2].m, in[2].m, _MM_SHUFFLE(3, 0, 1, 2));
+
+            _mm_storeu_ps(p,     _mm_blend_ps(_mm_blend_ps(x, y, 0b0010), z, 0b0100));
+            _mm_storeu_ps(p + 4, _mm_blend_ps(_mm_blend_ps(y, z, 0b0010), x, 0b0100));
+            _mm_storeu_ps(p + 8, _mm_blend_ps(_mm_blend_ps(z, x, 0b0010), y, 0b0100));
+        } else if constexpr (Derived::Size == 4 && N == 4) {
+            __m128 t0 = _mm_unpacklo_ps(in[0].m, in[1].m),
+                   t1 = _mm_unpacklo_ps(in[2].m, in[3].m),
+                   t2 = _mm_unpackhi_ps(in[0].m, in[1].m),
+                   t3 = _mm_unpackhi_ps(in[2].m, in[3].m);
+
+            _mm_storeu_ps(p,      _mm_movelh_ps(t0, t1));
+            _mm_storeu_ps(p + 4,  _mm_movehl_ps(t1, t0));
+            _mm_storeu_ps(p + 8,  _mm_movelh_ps(t2, t3));
+            _mm_storeu_ps(p + 12, _mm_movehl_ps(t3, t2));
+        } else {
+            Base::template store_aos_<N>(ptr, in);
+        }
+    }
+
 #if defined(DRJIT_X86_AVX2)
     template <typename Index, typename Mask>
     static DRJIT_INLINE Derived gather_(const void *ptr, const Index &index, const Mask &mask, ReduceMode) {
@@ -1187,6 +1253,29 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
     static DRJIT_INLINE Derived zero_(size_t) { return _mm_setzero_pd(); }
     static DRJIT_INLINE Derived empty_(size_t) { return _mm_undefined_pd(); }
 
+    template <size_t N>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        if constexpr (N == 2) {
+            const double *p = (const double *) ptr;
+            __m128d a = _mm_loadu_pd(p), b = _mm_loadu_pd(p + 2);
+            out[0] = _mm_unpacklo_pd(a, b);
+            out[1] = _mm_unpackhi_pd(a, b);
+        } else {
+            Base::template load_aos_<N>(ptr, out);
+        }
+    }
+
+    template <size_t N>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        if constexpr (N == 2) {
+            double *p = (double *) ptr;
+            _mm_storeu_pd(p,     _mm_unpacklo_pd(in[0].m, in[1].m));
+            _mm_storeu_pd(p + 2, _mm_unpackhi_pd(in[0].m, in[1].m));
+        } else {
+            Base::template store_aos_<N>(ptr, in);
+        }
+    }
+
 #if defined(DRJIT_X86_AVX2)
     template <typename Index, typename Mask>
     static DRJIT_INLINE Derived gather_(const void *ptr, const Index &index, const Mask &mask, bool) {
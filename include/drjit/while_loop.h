@@ -20,7 +20,7 @@ NAMESPACE_BEGIN(detail)
 template <typename StateD, size_t... Is, typename State, typename Cond,
           typename Body>
 StateD while_loop_impl(std::index_sequence<Is...>, State &&state_, Cond &&cond,
-                       Body &&body, const char *name) {
+                       Body &&body, const char *name, int unroll) {
     using namespace std; // for ADL lookup to drjit::get<I> or std::get<I>
 
     using Mask = std::decay_t<decltype(cond(get<Is>(state_)...))>;
@@ -28,6 +28,7 @@ StateD while_loop_impl(std::index_sequence<Is...>, State &&state_, Cond &&cond,
     if constexpr (std::is_same_v<Mask, bool>) {
         // This is a simple scalar loop
         DRJIT_MARK_USED(name);
+        DRJIT_MARK_USED(unroll);
         StateD state(std::forward<State>(state_));
         while (cond(get<Is>(state)...))
             body(get<Is>(state)...);
@@ -36,6 +37,7 @@ StateD while_loop_impl(std::index_sequence<Is...>, State &&state_, Cond &&cond,
     } else if constexpr (is_array_v<Mask> && !is_jit_v<Mask>) {
         // This is a packet-based vectorized loop
         DRJIT_MARK_USED(name);
+        DRJIT_MARK_USED(unroll);
         StateD state(std::forward<State>(state_));
         Mask active = true;
 
@@ -84,7 +86,7 @@ StateD while_loop_impl(std::index_sequence<Is...>, State &&state_, Cond &&cond,
             new Payload{ std::forward<State>(state_), std::forward<Cond>(cond),
                          std::forward<Body>(body), Mask() });
 
-        bool all_done = ad_loop(Mask::Backend, -1, -1, 0, name, payload.get(), read_cb,
+        bool all_done = ad_loop(Mask::Backend, -1, -1, 0, unroll, name, payload.get(), read_cb,
                                 write_cb, cond_cb, body_cb, delete_cb, true);
 
         StateD state = std::move(payload->state);
@@ -98,14 +100,22 @@ StateD while_loop_impl(std::index_sequence<Is...>, State &&state_, Cond &&cond,
 
 NAMESPACE_END(detail)
 
+/**
+ * \brief Repeatedly run \c body on the tuple \c state while \c cond holds
+ *
+ * For Jit-compiled loops, a value of \c unroll greater than one traces this
+ * many iterations per copy of the loop body, and \c -1 fully unrolls a loop
+ * whose condition is a literal constant in every iteration. See \ref
+ * ad_loop() for details.
+ */
 template <typename State, typename Cond, typename Body>
 std::decay_t<State> while_loop(State &&state, Cond &&cond, Body &&body,
-                               const char *name = nullptr) {
+                               const char *name = nullptr, int unroll = 0) {
     using StateD = std::decay_t<State>;
     return detail::while_loop_impl<StateD>(
         std::make_index_sequence<std::tuple_size<StateD>::value>(),
         std::forward<State>(state), std::forward<Cond>(cond),
-        std::forward<Body>(body), name);
+        std::forward<Body>(body), name, unroll);
 }
 
 NAMESPACE_END(drjit)
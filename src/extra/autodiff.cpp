@@ -17,7 +17,9 @@
  *   simple edge records an edge weight that scales gradients flowing along
  *   it. Special edges implement more complex gradient transformation via
  *   callbacks. Operations that exchange across array entries (e.g.,
- *   scatter/gather) require such special edges.
+ *   scatter/gather) require such special edges. The weights and callbacks
+ *   are stored separately in ``state.edge_data`` so that graph traversal
+ *   only touches the compact topology information.
  *
  * - ``local_state.todo``: A list of edges that should be traversed by the next
  *   call to ``ad_traverse()``. This list is thread-local in contrast to the
@@ -52,8 +54,10 @@
 #include <tsl/robin_set.h>
 #include <tsl/robin_map.h>
 #include <nanobind/intrusive/counter.inl>
-#include <queue>
+#include <nanothread/nanothread.h>
 #include <mutex>
+#include <atomic>
+#include <exception>
 
 namespace dr = drjit;
 
@@ -146,19 +150,17 @@ DRJIT_INLINE JitVar scalar(Index index, double value) {
 struct Special;
 
 /**
- * Represents an edge in the AD graph that furthermore stores either
- *
- * 1. An edge weight that scales gradients passing along this edge
- *
- * 2. An unspecified instance of the 'Special' interface that implements
- *    some more advanced way of transforming gradients between source/target
- *    variable. Masking and scatter/gather operations, e.g., require this.
+ * Represents the topology of an edge in the AD graph.
  *
  * Instead of storing an explicit adjacency list of the AD graph structure, the
  * adjacency information is directly encoded in the edges. In particular, the
  * 'next_fwd' and 'next_bwd' indices each implement a singly linked list that
  * can be used to iterate through the forward edges (of the 'source' variable)
  * and backward edges (of the 'target' variable).
+ *
+ * This data structure only contains fields needed to traverse the graph
+ * structure (e.g. in ``ad_dfs_fwd()``). The associated weight or callback
+ * is stored in a separate \ref EdgeData record with the same index.
  */
 struct Edge {
     /// Variable index of source operand
@@ -173,22 +175,34 @@ struct Edge {
     /// Link to the next backward edge
     EdgeIndex next_bwd = 0;
 
-    /// Special edge handler
-    dr::unique_ptr<Special> special;
-
-    /// Edge weight
-    JitVar weight;
-
     /// Visited flag for DFS traversal
     bool visited = false;
 
-    /// Does edge.special store an instance of 'CopyGrad'?
+    /// Does the associated 'EdgeData::special' store an instance of 'CopyGrad'?
     bool copy_grad = false;
 
-    /// Does edge.special store an instance of 'CustomOp'?
+    /// Does the associated 'EdgeData::special' store an instance of 'CustomOp'?
     bool is_custom = false;
 };
 
+/**
+ * Payload of an edge that is only accessed when gradients flow along it. It
+ * stores either
+ *
+ * 1. An edge weight that scales gradients passing along this edge
+ *
+ * 2. An unspecified instance of the 'Special' interface that implements
+ *    some more advanced way of transforming gradients between source/target
+ *    variable. Masking and scatter/gather operations, e.g., require this.
+ */
+struct EdgeData {
+    /// Special edge handler
+    dr::unique_ptr<Special> special;
+
+    /// Edge weight
+    JitVar weight;
+};
+
 /// Flags characterizing the 'Variable.flags' bit field
 enum VariableFlags : uint8_t {
     /// Was this AD node created while capturing symbolic computation in the
@@ -224,29 +238,36 @@ enum VariableFlags : uint8_t {
  * the forward or backward direction, is represented using linked lists. The
  * 'next_fwd' and 'next_bwd' fields each provide an entry point into such a
  * linked list of edges (see also \ref Edge).
+ *
+ * Fields needed by graph traversal are grouped at the beginning of the data
+ * structure. The rarely accessed variable label lives in a separate side
+ * table (``state.labels``).
  */
 struct Variable {
-    /// Number of references to this AD variable
-    uint32_t ref_count = 0;
+    /**
+     * \brief Number of references to this AD variable
+     *
+     * This field is atomic so that threads can acquire and release references
+     * to variables that they already hold without entering the critical
+     * section protected by ``State::mutex`` (see ``ad_var_inc_ref_impl()``
+     * and ``ad_var_dec_ref_impl()``).
+     */
+    std::atomic<uint32_t> ref_count { 0 };
 
-    /// Link to the first forward edge at this node
-    EdgeIndex next_fwd = 0;
+    /**
+     * \brief Link to the first forward edge at this node
+     *
+     * ``ad_var_new_impl()`` prepends edges to this list without holding
+     * ``State::mutex`` (see ``ad_edge_push_fwd()``). Code that removes edges
+     * from the list holds the lock and must use ``ad_edge_relink_fwd()``,
+     * which tolerates concurrent insertions. All other fields require the
+     * lock once the variable has been published.
+     */
+    std::atomic<EdgeIndex> next_fwd { 0 };
 
     /// Link to the first backward edge at this node
     EdgeIndex next_bwd = 0;
 
-    /// JIT variable index referencing the gradient
-    JitVar grad;
-
-    /// Size of the associated primal variable
-    size_t size = 0;
-
-    /// Descriptive label
-    char *label = nullptr;
-
-    /// Value of the ``state.counter`` field when this variable was created
-    uint64_t counter = 0;
-
     /// JIT backend associated with this variable
     uint8_t backend = 0;
 
@@ -256,37 +277,42 @@ struct Variable {
     /// Custom flags (see the 'VariableFlag' enum above)
     uint8_t flags = 0;
 
+    /// Value of the ``state.counter`` field when this variable was created
+    uint64_t counter = 0;
+
+    /// JIT variable index referencing the gradient
+    JitVar grad;
+
+    /// Size of the associated primal variable
+    size_t size = 0;
+
     Variable() = default;
 
     Variable(const Variable &) = delete;
     Variable &operator=(const Variable &) = delete;
 
     Variable(Variable &&v) noexcept
-        : ref_count(v.ref_count), next_fwd(v.next_fwd), next_bwd(v.next_bwd),
-          grad(std::move(v.grad)), size(v.size), label(v.label),
-          counter(v.counter), backend(v.backend), type(v.type), flags(v.flags) {
-        v.label = nullptr;
-    }
+        : ref_count(v.ref_count.load(std::memory_order_relaxed)),
+          next_fwd(v.next_fwd.load(std::memory_order_relaxed)),
+          next_bwd(v.next_bwd), backend(v.backend),
+          type(v.type), flags(v.flags), counter(v.counter),
+          grad(std::move(v.grad)), size(v.size) { }
 
     Variable &operator=(Variable &&v) noexcept {
-        ref_count = v.ref_count; next_fwd = v.next_fwd;
-        next_bwd = v.next_bwd; grad = std::move(v.grad);
-        size = v.size;
-        if (flags & (uint8_t) VariableFlags::FreeLabel)
-            free(label);
-        label = v.label; v.label = nullptr;
-        counter = v.counter;
+        ref_count.store(v.ref_count.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+        next_fwd.store(v.next_fwd.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+        next_bwd = v.next_bwd;
         backend = v.backend;
         type = v.type;
         flags = v.flags;
+        counter = v.counter;
+        grad = std::move(v.grad);
+        size = v.size;
         return *this;
     }
 
-    ~Variable() {
-        if (flags & (uint8_t) VariableFlags::FreeLabel)
-            free(label);
-    }
-
     /**
      * \brief Multiply-accumulate a gradient (i.e., ``grad += v1*v2``), where
      * ``v2`` is typically the weight of an AD edge.
@@ -373,27 +399,275 @@ struct Variable {
     }
 };
 
+/**
+ * \brief Segmented array with stable element addresses
+ *
+ * Entries are stored in a sequence of geometrically growing blocks: block 0
+ * holds the first ``2^MinLog2`` entries, and each subsequent block ``k > 0``
+ * holds the ``2^(MinLog2 + k - 1)`` entries following it. In contrast to
+ * ``std::vector``, growing the array never relocates existing entries, and the
+ * block table has a fixed size. Looking up an entry is therefore safe even
+ * while another thread appends to the array.
+ *
+ * Appending entries requires external synchronization (``State::mutex``).
+ */
+template <typename T, uint32_t MinLog2 = 10> struct BlockStorage {
+    static constexpr uint32_t BlockCount = 32 - MinLog2 + 1;
+
+    BlockStorage() = default;
+    BlockStorage(const BlockStorage &) = delete;
+    BlockStorage &operator=(const BlockStorage &) = delete;
+
+    ~BlockStorage() {
+        for (uint32_t i = 0; i < BlockCount; ++i)
+            delete[] m_blocks[i].load(std::memory_order_relaxed);
+    }
+
+    /// Return the number of entries in the given block
+    static constexpr uint32_t block_size(uint32_t block) {
+        return block == 0 ? (1u << MinLog2) : (1u << (MinLog2 + block - 1));
+    }
+
+    /// Map an index to a block ID and an offset within that block
+    static DRJIT_INLINE std::pair<uint32_t, uint32_t> locate(uint32_t index) {
+        if (index < (1u << MinLog2))
+            return { 0u, index };
+        uint32_t l = dr::log2i(index);
+        return { l - MinLog2 + 1, index - (1u << l) };
+    }
+
+    DRJIT_INLINE T &operator[](size_t index) {
+        auto [block, offset] = locate((uint32_t) index);
+        return m_blocks[block].load(std::memory_order_acquire)[offset];
+    }
+
+    DRJIT_INLINE const T &operator[](size_t index) const {
+        auto [block, offset] = locate((uint32_t) index);
+        return m_blocks[block].load(std::memory_order_acquire)[offset];
+    }
+
+    size_t size() const { return m_size.load(std::memory_order_acquire); }
+
+    /// Append a default-constructed entry
+    T &emplace_back() {
+        uint32_t index = m_size.load(std::memory_order_relaxed);
+        auto [block, offset] = locate(index);
+
+        T *ptr = m_blocks[block].load(std::memory_order_relaxed);
+        if (!ptr) {
+            ptr = new T[block_size(block)]();
+            m_blocks[block].store(ptr, std::memory_order_release);
+        }
+
+        m_size.store(index + 1, std::memory_order_release);
+        return ptr[offset];
+    }
+
+    /**
+     * \brief Reduce the size of the array to ``size`` entries and release
+     * blocks that no longer hold any entries.
+     *
+     * The caller must ensure that the removed entries are unused and in their
+     * default-constructed state, since a partially retained block may hand
+     * them out again in a subsequent call to ``emplace_back()``.
+     */
+    void shrink(uint32_t size) {
+        for (uint32_t i = BlockCount - 1; i > 0; --i) {
+            uint32_t start = 1u << (MinLog2 + i - 1);
+            if (start < size)
+                break;
+            delete[] m_blocks[i].exchange(nullptr, std::memory_order_acq_rel);
+        }
+        m_size.store(size, std::memory_order_release);
+    }
+
+private:
+    std::atomic<T *> m_blocks[BlockCount] { };
+    std::atomic<uint32_t> m_size { 0 };
+};
+
+/**
+ * \brief Hierarchical bitmap that tracks the unused entries of a
+ * ``BlockStorage`` instance
+ *
+ * Level 0 stores one bit per entry, which is set when the entry is unused.
+ * Each bit of level ``k > 0`` records whether the associated 64-bit word of
+ * level ``k - 1`` is nonzero, and the topmost level consists of a single word.
+ * Allocating the lowest unused entry therefore only requires a descent
+ * through ``O(log64(n))`` words (at most 6 for 32-bit indices), and the same
+ * is true for releasing an entry. In contrast to a binary heap, both
+ * operations are effectively constant-time, while the preference for low
+ * indices (which improves memory locality) is retained.
+ */
+struct FreeList {
+    /// Does the list contain any unused entries?
+    bool empty() const { return m_count == 0; }
+
+    /// Return the number of unused entries
+    size_t size() const { return m_count; }
+
+    /// Mark the entry ``index`` as unused
+    void push(uint32_t index) {
+        reserve(index);
+
+        for (size_t l = 0; l < m_levels.size(); ++l) {
+            uint64_t &word = m_levels[l][index >> 6],
+                     prev  = word;
+            ad_assert(!(prev & (1ull << (index & 63))),
+                      "FreeList::push(): entry %u was released twice!", index);
+            word = prev | (1ull << (index & 63));
+            if (prev)
+                break;
+            index >>= 6;
+        }
+
+        m_count++;
+    }
+
+    /// Remove and return the lowest unused entry (the list must be nonempty)
+    uint32_t pop() {
+        ad_assert(m_count > 0, "FreeList::pop(): list is empty!");
+
+        uint32_t index = 0;
+        for (size_t l = m_levels.size(); l > 0; --l)
+            index = (index << 6) + (uint32_t) dr::detail::tzcnt_(m_levels[l - 1][index]);
+
+        uint32_t result = index;
+        for (size_t l = 0; l < m_levels.size(); ++l) {
+            uint64_t &word = m_levels[l][index >> 6];
+            word &= ~(1ull << (index & 63));
+            if (word)
+                break;
+            index >>= 6;
+        }
+
+        m_count--;
+        return result;
+    }
+
+    /**
+     * \brief Remove the trailing run of unused entries below ``size``.
+     *
+     * Returns the new size, i.e., one past the highest entry that is in use.
+     * Entry 0 is never part of the list, hence the result is at least 1.
+     */
+    uint32_t truncate(uint32_t size) {
+        if (m_levels.empty())
+            return size;
+
+        uint32_t new_size = size;
+        while (new_size > 0 && is_unused(new_size - 1)) {
+            uint32_t i = new_size - 1;
+            if ((i & 63) == 63 && m_levels[0][i >> 6] == ~0ull)
+                new_size -= 64; // skip over a fully unused word
+            else
+                new_size -= 1;
+        }
+
+        if (new_size == size)
+            return size;
+
+        m_count -= size - new_size;
+
+        // Discard level-0 bits past the end, then recompute the last word of
+        // every summary level
+        size_t n = ((size_t) new_size + 63) / 64;
+        m_levels[0].resize(n);
+        if (new_size & 63)
+            m_levels[0][n - 1] &= (1ull << (new_size & 63)) - 1;
+
+        for (size_t l = 1; l < m_levels.size(); ++l) {
+            const std::vector<uint64_t> &below = m_levels[l - 1];
+            std::vector<uint64_t> &words = m_levels[l];
+            size_t n2 = (below.size() + 63) / 64;
+            words.resize(n2);
+
+            uint64_t word = 0;
+            size_t base = (n2 - 1) * 64;
+            for (size_t i = base; i < below.size(); ++i)
+                word |= (uint64_t) (below[i] != 0) << (i - base);
+            words[n2 - 1] = word;
+        }
+
+        return new_size;
+    }
+
+private:
+    bool is_unused(uint32_t index) const {
+        size_t word = index >> 6;
+        return word < m_levels[0].size() &&
+               (m_levels[0][word] & (1ull << (index & 63)));
+    }
+
+    /// Grow the bitmap so that it can track the entry ``index``
+    void reserve(uint32_t index) {
+        size_t n = ((size_t) index >> 6) + 1;
+
+        if (m_levels.empty())
+            m_levels.emplace_back();
+        else if (m_levels[0].size() >= n)
+            return;
+
+        m_levels[0].resize(n, 0);
+
+        for (size_t l = 1; l < m_levels.size() || m_levels[l - 1].size() > 1; ++l) {
+            size_t n2 = (m_levels[l - 1].size() + 63) / 64;
+
+            if (l == m_levels.size()) {
+                // Add a new summary level. Only the first word of the level
+                // below existed before, the rest was just zero-initialized.
+                std::vector<uint64_t> words(n2, 0);
+                words[0] = m_levels[l - 1][0] != 0;
+                m_levels.push_back(std::move(words));
+            } else {
+                m_levels[l].resize(n2, 0);
+            }
+        }
+    }
+
+    std::vector<std::vector<uint64_t>> m_levels;
+    size_t m_count = 0;
+};
+
 /// Represents the global state of the AD system
 struct State {
     /// std::mutex protecting the state data structure
     std::mutex mutex;
 
-    /// Hash table mapping variable IDs to variable instances
-    std::vector<Variable> variables;
+    /// Segmented array mapping variable IDs to variable instances
+    BlockStorage<Variable> variables;
+
+    /// Variable labels (cold side table indexed like ``variables``)
+    BlockStorage<char *> labels;
 
     /// List of all edges (used and unused ones)
-    std::vector<Edge> edges;
+    BlockStorage<Edge> edges;
 
-    /// Sorted list of currently unused edges and vertices
-    std::priority_queue<ADIndex, std::vector<ADIndex>, std::greater<uint32_t>> unused_variables;
-    std::priority_queue<EdgeIndex, std::vector<EdgeIndex>, std::greater<uint32_t>> unused_edges;
+    /// Edge weights and callbacks (cold side table indexed like ``edges``)
+    BlockStorage<EdgeData> edge_data;
+
+    /// Bitmaps tracking currently unused edges and vertices. Threads
+    /// reserve batches of them ahead of time (see ``ad_local_reserve()``)
+    FreeList unused_variables;
+    FreeList unused_edges;
 
     /// Counter to establish an ordering among variables
-    uint64_t counter = 0;
+    std::atomic<uint64_t> counter { 0 };
+
+    /// Budget for unevaluated gradients during AD traversal (0: unlimited)
+    size_t memory_budget = 0;
+
+    /// Automatically compact the graph when it exceeds this many variables
+    std::atomic<size_t> compact_threshold { 0 };
+
+    /// Variable count that triggers the next automatic compaction
+    size_t compact_next = 0;
 
     State() {
-        variables.resize(1);
-        edges.resize(1);
+        variables.emplace_back();
+        labels.emplace_back();
+        edges.emplace_back();
+        edge_data.emplace_back();
     }
 
     ~State() {
@@ -409,7 +683,8 @@ struct State {
                 if (variables[i].ref_count == 0)
                     continue;
 
-                ad_warn(" - variable a%zu (%u references)", i, variables[i].ref_count);
+                ad_warn(" - variable a%zu (%u references)", i,
+                        variables[i].ref_count.load());
                 if (++count == 10) {
                     ad_warn(" - (skipping the rest)");
                     break;
@@ -423,10 +698,18 @@ struct State {
     }
 
     Variable *operator[](ADIndex index) {
-        if (unlikely(index > variables.size() || variables[index].ref_count == 0))
+        if (unlikely(index >= variables.size() || variables[index].ref_count == 0))
             ad_fail("Referenced an unknown variable a%u!", index);
         return &variables[index];
     }
+
+    /// Look up a variable without taking the lock. The caller must hold a
+    /// reference to it, which prevents concurrent deallocation.
+    Variable *lookup_unlocked(ADIndex index) {
+        ad_assert(index < variables.size(),
+                  "Referenced an unknown variable a%u!", index);
+        return &variables[index];
+    }
 };
 
 // Special edge (scatter, gather, scatter_reduce, block_sum, etc.)
@@ -573,33 +856,138 @@ struct LocalState {
     /// Nested scopes that restrict AD to specific variables
     std::vector<Scope> scopes;
 
-    ~LocalState() {
-        if (!scopes.empty())
-            ad_warn("Scope leak detected (%zu scopes remain in use)!",
-                    scopes.size());
-    }
+    /// Variable and edge indices reserved by this thread, which it can
+    /// allocate without entering the critical section
+    std::vector<ADIndex> reserved_variables;
+    std::vector<EdgeIndex> reserved_edges;
+
+    ~LocalState();
 };
 
 static State state;
 static thread_local LocalState local_state;
 
-#if defined(DRJIT_SANITIZE_INTENSE)
-static void ad_sanitation_checkpoint_variables() {
-    state.variables.emplace_back();
-    state.variables.pop_back();
-    state.variables.shrink_to_fit();
+LocalState::~LocalState() {
+    if (!scopes.empty())
+        ad_warn("Scope leak detected (%zu scopes remain in use)!",
+                scopes.size());
+
+    // Return unused reservations (see ``ad_local_reserve()``)
+    if (!reserved_variables.empty() || !reserved_edges.empty()) {
+        std::lock_guard<std::mutex> guard(state.mutex);
+        for (ADIndex index : reserved_variables)
+            state.unused_variables.push(index);
+        for (EdgeIndex index : reserved_edges)
+            state.unused_edges.push(index);
+    }
 }
-static void ad_sanitation_checkpoint_edges() {
-    state.edges.emplace_back();
-    state.edges.pop_back();
-    state.edges.shrink_to_fit();
+
+/// Return the label of an AD variable (or \c nullptr if there is none)
+static const char *ad_label(ADIndex index) { return state.labels[index]; }
+
+/**
+ * Replace the label of an AD variable. When ``owned`` is set, the AD system
+ * takes ownership of ``label`` and eventually releases it via ``free()``.
+ */
+static void ad_set_label(ADIndex index, Variable *v, char *label, bool owned) {
+    char *&entry = state.labels[index];
+    if (v->flags & (uint8_t) VariableFlags::FreeLabel)
+        free(entry);
+    entry = label;
+
+    if (owned)
+        v->flags |= (uint8_t) VariableFlags::FreeLabel;
+    else
+        v->flags &= ~(uint8_t) VariableFlags::FreeLabel;
 }
-static void ad_sanitation_checkpoint_both() {
-    ad_sanitation_checkpoint_variables();
-    ad_sanitation_checkpoint_edges();
+
+/**
+ * Release trailing storage of ``state.variables`` and ``state.edges`` that
+ * is no longer in use. This is an O(1) operation unless there is actually
+ * something to release.
+ */
+static void ad_compact() {
+    uint32_t vsize = (uint32_t) state.variables.size(),
+             esize = (uint32_t) state.edges.size(),
+             vsize_new = state.unused_variables.truncate(vsize),
+             esize_new = state.unused_edges.truncate(esize);
+
+    if (vsize_new != vsize) {
+        state.variables.shrink(vsize_new);
+        state.labels.shrink(vsize_new);
+        ad_log("ad_compact(): shrunk variable storage (%u -> %u entries).",
+               vsize, vsize_new);
+    }
+
+    if (esize_new != esize) {
+        state.edges.shrink(esize_new);
+        state.edge_data.shrink(esize_new);
+        ad_log("ad_compact(): shrunk edge storage (%u -> %u entries).",
+               esize, esize_new);
+    }
 }
+
+#if defined(DRJIT_SANITIZE_INTENSE)
+/* Variables and edges have stable addresses (see BlockStorage), but
+   compaction may release blocks. Do this eagerly to catch dangling
+   pointers into released storage. */
+static void ad_sanitation_checkpoint() { ad_compact(); }
 #endif
 
+/**
+ * \brief Prepend the edge ``index`` to the forward edge list of ``v``
+ *
+ * This does not require ``State::mutex``. Other threads may concurrently
+ * insert edges, and a thread holding the lock may concurrently remove them
+ * via \ref ad_edge_relink_fwd().
+ */
+static void ad_edge_push_fwd(Variable *v, EdgeIndex index) {
+    Edge &edge = state.edges[index];
+    EdgeIndex head = v->next_fwd.load(std::memory_order_relaxed);
+
+    do {
+        edge.next_fwd = head;
+    } while (!v->next_fwd.compare_exchange_weak(head, index,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+}
+
+/**
+ * \brief Replace the edge ``index`` in the forward edge list of variable
+ * ``source`` by ``repl``
+ *
+ * When ``repl`` equals the successor of ``index``, this removes the edge from
+ * the list. Otherwise, the caller must already have linked ``repl`` to that
+ * successor. The caller must hold ``State::mutex``. Concurrent insertions by
+ * \ref ad_edge_push_fwd() only ever modify the head of the list, hence a
+ * failed attempt to update the head means that the edge is further down.
+ */
+static void ad_edge_relink_fwd(ADIndex source, Variable *v, EdgeIndex index,
+                               EdgeIndex repl) {
+    DRJIT_MARK_USED(source);
+    EdgeIndex cur = index;
+
+    if (v->next_fwd.compare_exchange_strong(cur, repl,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire))
+        return;
+
+    while (true) {
+        ad_assert(cur, "ad_edge_relink_fwd(): could not find forward edge "
+                       "e%u of variable a%u!", index, source);
+        Edge &edge = state.edges[cur];
+        ad_assert(edge.source == source,
+                  "ad_edge_relink_fwd(): invalid edge connectivity!");
+
+        if (edge.next_fwd == index) {
+            edge.next_fwd = repl;
+            break;
+        }
+
+        cur = edge.next_fwd;
+    }
+}
+
 
 // Forward declarations
 static void ad_free(ADIndex, Variable *);
@@ -614,16 +1002,18 @@ static bool DRJIT_NOINLINE ad_decref_custom_op_output(Variable *);
 
 static void ad_var_inc_ref_int(ADIndex index, Variable *v) noexcept {
     DRJIT_MARK_USED(index);
-    ad_trace("ad_var_inc_ref(a%u): %u", index, v->ref_count + 1);
-    v->ref_count++;
+    uint32_t prev = v->ref_count.fetch_add(1, std::memory_order_relaxed);
+    ad_trace("ad_var_inc_ref(a%u): %u", index, prev + 1);
+    DRJIT_MARK_USED(prev);
 }
 
 static bool ad_var_dec_ref_int(ADIndex index, Variable *v) noexcept {
     DRJIT_MARK_USED(index);
-    ad_trace("ad_var_dec_ref(a%u): %u", index, v->ref_count - 1);
-    ad_assert(v->ref_count > 0, "ad_var_dec_ref_int(): reference count underflow");
+    uint32_t prev = v->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+    ad_trace("ad_var_dec_ref(a%u): %u", index, prev - 1);
+    ad_assert(prev > 0, "ad_var_dec_ref_int(): reference count underflow");
 
-    if (--v->ref_count > 0) {
+    if (prev - 1 > 0) {
         if (unlikely(v->flags & (uint8_t) VariableFlags::CustomOpOutput))
             return ad_decref_custom_op_output(v);
         else
@@ -652,28 +1042,12 @@ static void ad_free_edges(uint32_t index, Variable *v) {
         EdgeIndex next_bwd = edge.next_bwd,
                   next_fwd = edge.next_fwd;
 
-        edge = Edge { };
-
         Variable *v2 = state[source];
-        if (!ad_var_dec_ref_int(source, v2)) {
-            EdgeIndex fwd = v2->next_fwd;
+        if (!ad_var_dec_ref_int(source, v2))
+            ad_edge_relink_fwd(source, v2, edge_id, next_fwd);
 
-            if (fwd == edge_id) {
-                v2->next_fwd = next_fwd;
-            } else {
-                while (true) {
-                    Edge &edge2 = state.edges[fwd];
-                    ad_assert(edge2.source == source,
-                              "ad_free_edges(): invalid edge connectivity!");
-                    if (edge2.next_fwd != edge_id) {
-                        fwd = edge2.next_fwd;
-                    } else {
-                        edge2.next_fwd = next_fwd;
-                        break;
-                    }
-                }
-            }
-        }
+        edge = Edge { };
+        state.edge_data[edge_id] = EdgeData { };
 
         state.unused_edges.push(edge_id);
 
@@ -685,11 +1059,36 @@ static void ad_free(ADIndex index, Variable *v) {
     ad_trace("ad_free(a%u)", index);
 
     ad_free_edges(index, v);
+    ad_set_label(index, v, nullptr, false);
 
     *v = Variable { };
     state.unused_variables.push(index);
 }
 
+/**
+ * \brief Try to increase the reference count of a variable without entering
+ * the critical section
+ *
+ * ``ad_decref_custom_op_output()`` inspects the reference count while holding
+ * ``State::mutex``. To keep that check stable, transitions to the values 2
+ * and 3 are left to the caller, which performs them under the lock.
+ */
+static bool ad_var_inc_ref_fast(ADIndex index, Variable *v) noexcept {
+    DRJIT_MARK_USED(index);
+    uint32_t value = v->ref_count.load(std::memory_order_relaxed);
+
+    while (value > 2) {
+        if (v->ref_count.compare_exchange_weak(value, value + 1,
+                                               std::memory_order_relaxed,
+                                               std::memory_order_relaxed)) {
+            ad_trace("ad_var_inc_ref(a%u): %u", index, value + 1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 Index ad_var_inc_ref_impl(Index index) JIT_NOEXCEPT {
     JitIndex jit_index = ::jit_index(index);
     ADIndex ad_index = ::ad_index(index);
@@ -702,21 +1101,55 @@ Index ad_var_inc_ref_impl(Index index) JIT_NOEXCEPT {
             scopes.back().maybe_disable(ad_index);
 
         if (ad_index) {
-            std::lock_guard<std::mutex> guard(state.mutex);
-            ad_var_inc_ref_int(ad_index, state[ad_index]);
+            // The caller holds a reference, so the variable cannot be freed
+            // concurrently. Only enter the critical section when the
+            // increment could race with the cleanup of a 'CustomOp' output.
+            Variable *v = state.lookup_unlocked(ad_index);
+            if (!ad_var_inc_ref_fast(ad_index, v)) {
+                std::lock_guard<std::mutex> guard(state.mutex);
+                ad_var_inc_ref_int(ad_index, v);
+            }
         }
     }
 
     return combine(ad_index, jit_index);
 }
 
+/**
+ * \brief Try to decrease the reference count of a variable without entering
+ * the critical section
+ *
+ * This succeeds when the operation provably neither frees the variable nor
+ * interacts with the cleanup of a 'CustomOp' output (see
+ * ``ad_decref_custom_op_output()``). Both of these cases modify the AD graph
+ * and must be handled while holding ``State::mutex``. The latter inspects the
+ * reference count under the lock and expects it to remain stable, hence any
+ * transition into or out of the value 2 (i.e., 3->2 and 2->1) takes the slow
+ * path.
+ */
+static bool ad_var_dec_ref_fast(ADIndex index, Variable *v) noexcept {
+    DRJIT_MARK_USED(index);
+    uint32_t value = v->ref_count.load(std::memory_order_relaxed);
+
+    while (value > 3) {
+        if (v->ref_count.compare_exchange_weak(value, value - 1,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_relaxed)) {
+            ad_trace("ad_var_dec_ref(a%u): %u", index, value - 1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 
 uint32_t ad_var_ref(uint64_t index) {
     uint32_t ad_index = ::ad_index(index);
     if (!ad_index)
         return 0;
     std::lock_guard<std::mutex> guard(state.mutex);
-    return state[ad_index]->ref_count;
+    return state[ad_index]->ref_count.load(std::memory_order_relaxed);
 }
 
 void ad_var_dec_ref_impl(Index index) JIT_NOEXCEPT {
@@ -726,6 +1159,9 @@ void ad_var_dec_ref_impl(Index index) JIT_NOEXCEPT {
     jit_var_dec_ref(jit_index);
 
     if (unlikely(ad_index)) {
+        if (ad_var_dec_ref_fast(ad_index, state.lookup_unlocked(ad_index)))
+            return;
+
         std::lock_guard<std::mutex> guard(state.mutex);
         ad_var_dec_ref_int(ad_index, state[ad_index]);
     }
@@ -751,6 +1187,63 @@ char *concat(const char *s1, const char *s2) {
     return buf;
 }
 
+/// Number of variable and edge indices that a thread reserves at once
+static constexpr size_t LocalReserveCount = 64;
+
+/**
+ * \brief Top up the variable and edge indices reserved by the current thread
+ *
+ * ``ad_var_new_impl()`` allocates from these reservations so that it does not
+ * need to enter the critical section for most operations. Reserved entries
+ * are neither part of the free lists nor referenced, hence compaction and
+ * graph traversal in other threads leave them alone. They are returned to the
+ * free lists when the thread exits. The caller must hold ``State::mutex``.
+ */
+static void ad_local_reserve(LocalState &ls) {
+    auto &rv = ls.reserved_variables;
+    auto &re = ls.reserved_edges;
+
+    while (rv.size() < LocalReserveCount) {
+        if (state.unused_variables.empty()) {
+            rv.push_back((ADIndex) state.variables.size());
+            state.variables.emplace_back();
+            state.labels.emplace_back();
+        } else {
+            rv.push_back(state.unused_variables.pop());
+        }
+    }
+
+    while (re.size() < LocalReserveCount) {
+        if (state.unused_edges.empty()) {
+            re.push_back((EdgeIndex) state.edges.size());
+            state.edges.emplace_back();
+            state.edge_data.emplace_back();
+        } else {
+            re.push_back(state.unused_edges.pop());
+        }
+    }
+}
+
+/// Initialize a newly allocated variable
+static Variable *ad_var_init(ADIndex index, JitBackend backend, size_t size,
+                             VarType type, bool symbolic, const char *label) {
+    Variable *v = &state.variables[index];
+    v->ref_count.store(1, std::memory_order_relaxed);
+    v->size = size;
+    v->counter = state.counter.fetch_add(1, std::memory_order_relaxed);
+    v->backend = (uint8_t) backend;
+    v->type = (uint8_t) type;
+    v->flags = symbolic ? (uint8_t) VariableFlags::Symbolic : (uint8_t) 0;
+
+    const char *prefix = jit_prefix(backend);
+    if (prefix)
+        ad_set_label(index, v, concat(prefix, label), true);
+    else
+        ad_set_label(index, v, (char *) label, false);
+
+    return v;
+}
+
 /// Allocate a new variable from the pool
 static std::pair<ADIndex, Variable *> ad_var_new(JitBackend backend,
                                                  size_t size, VarType type,
@@ -764,32 +1257,12 @@ static std::pair<ADIndex, Variable *> ad_var_new(JitBackend backend,
     if (unlikely(unused.empty() || !reuse_indices)) {
         index = (ADIndex) state.variables.size();
         state.variables.emplace_back();
+        state.labels.emplace_back();
     } else {
-        index = unused.top();
-        unused.pop();
+        index = unused.pop();
     }
 
-#if defined(DRJIT_SANITIZE_INTENSE)
-    ad_sanitation_checkpoint_variables();
-#endif
-
-    Variable *v = &state.variables[index];
-    v->ref_count = 1;
-    v->size = size;
-    v->counter = state.counter++;
-    v->backend = (uint8_t) backend;
-    v->type = (uint8_t) type;
-    v->flags = symbolic ? (uint8_t) VariableFlags::Symbolic : (uint8_t) 0;
-
-    const char *prefix = jit_prefix(backend);
-    if (prefix) {
-        v->label = concat(prefix, label);
-        v->flags |= (uint8_t) VariableFlags::FreeLabel;
-    } else {
-        v->label = (char *) label;
-    }
-
-    return { index, v };
+    return { index, ad_var_init(index, backend, size, type, symbolic, label) };
 }
 
 /// Allocate a new edge from the pool
@@ -801,12 +1274,11 @@ static EdgeIndex ad_edge_new() {
         index = (EdgeIndex) state.edges.size();
         state.edges.emplace_back();
     } else {
-        index = unused.top();
-        unused.pop();
+        index = unused.pop();
     }
 
 #if defined(DRJIT_SANITIZE_INTENSE)
-    ad_sanitation_checkpoint_edges();
+    ad_sanitation_checkpoint();
 #endif
 
     return index;
@@ -896,7 +1368,8 @@ struct ReleaseHelper {
     }
 };
 
-/// Forward declaration of a helper function defined later on
+/// Forward declaration of helper functions defined later on
+static void ad_compact_graph_auto();
 uint32_t ad_record_implicit_dependence(LocalState &ls, ReleaseHelper &rl,
                                        JitBackend backend, uint32_t source,
                                        Variable *v_source, bool reuse_indices);
@@ -928,8 +1401,6 @@ DRJIT_NOINLINE Index ad_var_new_impl(const char *label, JitVar &&result,
     #pragma GCC diagnostic pop
 #endif
 
-    std::lock_guard<std::mutex> guard(state.mutex);
-
     /* Potentially turn off derivative tracking for some of the operands if
        we're within a scope that enables/disables gradient propagation
        (globally, or only for specific variables) */
@@ -957,6 +1428,25 @@ DRJIT_NOINLINE Index ad_var_new_impl(const char *label, JitVar &&result,
     bool symbolic      = flags & (uint32_t) JitFlag::SymbolicScope,
          reuse_indices = flags & (uint32_t) JitFlag::ReuseIndices;
 
+    /* Ordinary operations are recorded without entering the critical section:
+       the new variable and its edges come from indices reserved by the
+       current thread, and the edges are published by atomically prepending
+       them to the forward edge lists of the operands. The caller holds
+       references to all operands, which therefore cannot be freed or
+       collapsed in the meantime. Symbolic operations, index reuse being
+       disabled, and automatic graph compaction take the locked path. */
+    bool local = !symbolic && reuse_indices &&
+                 !state.compact_threshold.load(std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> guard(state.mutex, std::defer_lock);
+    if (!local) {
+        guard.lock();
+    } else if (ls.reserved_variables.empty() ||
+               ls.reserved_edges.size() < N + 1) {
+        std::lock_guard<std::mutex> guard_2(state.mutex);
+        ad_local_reserve(ls);
+    }
+
     VarInfo info = jit_set_backend(result.index());
     ReleaseHelper rh;
 
@@ -984,8 +1474,19 @@ DRJIT_NOINLINE Index ad_var_new_impl(const char *label, JitVar &&result,
         }
     }
 
-    auto [ad_index, var] = ad_var_new(info.backend, info.size, info.type,
-                                      symbolic, reuse_indices, label);
+    ADIndex ad_index;
+    Variable *var;
+
+    if (local) {
+        ad_index = ls.reserved_variables.back();
+        ls.reserved_variables.pop_back();
+        var = ad_var_init(ad_index, info.backend, info.size, info.type,
+                          symbolic, label);
+    } else {
+        std::tie(ad_index, var) = ad_var_new(info.backend, info.size, info.type,
+                                             symbolic, reuse_indices, label);
+    }
+
     const char *tname = jit_type_name(info.type);
 
     if constexpr (N == 0) {
@@ -1006,6 +1507,7 @@ DRJIT_NOINLINE Index ad_var_new_impl(const char *label, JitVar &&result,
 
     EdgeIndex edge_index = 0;
 
+    // Create the backward edges. They aren't visible to other threads yet.
     for (size_t i = 0; i < N; ++i) {
         ADIndex source = args[i].ad_index;
 
@@ -1020,31 +1522,38 @@ DRJIT_NOINLINE Index ad_var_new_impl(const char *label, JitVar &&result,
             }
         }
 
-        Variable *v_source = state[source];
+        EdgeIndex edge_index_new;
+        if (local) {
+            edge_index_new = ls.reserved_edges.back();
+            ls.reserved_edges.pop_back();
+        } else {
+            edge_index_new = ad_edge_new();
+        }
 
-        EdgeIndex edge_index_new = ad_edge_new();
         Edge &edge = state.edges[edge_index_new];
         edge.source = source;
         edge.target = ad_index;
-
-        if constexpr (std::is_same_v<ArgType, SpecialArg>)
-            edge.special = std::move(args[i].special);
-        else
-            edge.weight = std::move(args[i].weight);
-
-        edge.next_fwd = v_source->next_fwd;
         edge.next_bwd = edge_index;
         edge_index = edge_index_new;
 
-        ad_var_inc_ref_int(source, v_source);
-        v_source->next_fwd = edge_index_new;
+        EdgeData &data = state.edge_data[edge_index_new];
+        if constexpr (std::is_same_v<ArgType, SpecialArg>)
+            data.special = std::move(args[i].special);
+        else
+            data.weight = std::move(args[i].weight);
     }
 
     if constexpr (N > 0) {
         if (!edge_index) {
             // All edges were pruned, don't create the node after all
             ad_trace("ad_var_new(a%u): all edges pruned, removing variable.", ad_index);
-            ad_free(ad_index, var);
+            if (local) {
+                ad_set_label(ad_index, var, nullptr, false);
+                *var = Variable { };
+                ls.reserved_variables.push_back(ad_index);
+            } else {
+                ad_free(ad_index, var);
+            }
             return result.release();
         }
     }
@@ -1054,11 +1563,33 @@ DRJIT_NOINLINE Index ad_var_new_impl(const char *label, JitVar &&result,
     if (var->flags & (uint8_t) VariableFlags::Symbolic)
         ad_propagate_size(var);
 
+    // Publish the edges by adding them to the forward edge lists of the operands
+    for (EdgeIndex ei = edge_index; ei; ) {
+        const Edge &edge = state.edges[ei];
+        ADIndex source = edge.source;
+        Variable *v_source = local ? state.lookup_unlocked(source)
+                                   : state[source];
+
+        if (!local) {
+            ad_var_inc_ref_int(source, v_source);
+        } else if (!ad_var_inc_ref_fast(source, v_source)) {
+            std::lock_guard<std::mutex> guard_2(state.mutex);
+            ad_var_inc_ref_int(source, v_source);
+        }
+
+        ad_edge_push_fwd(v_source, ei);
+        ei = edge.next_bwd;
+    }
+
     /* If we're selectively tracking gradients and this operation generates a
        new AD variable, then its index must be added to the index set */
     if (unlikely(!scopes.empty()))
         scopes.back().enable(ad_index);
 
+    if (unlikely(!local && !symbolic &&
+                 state.compact_threshold.load(std::memory_order_relaxed)))
+        ad_compact_graph_auto();
+
     return combine(ad_index, result.release());
 }
 
@@ -1200,23 +1731,20 @@ Index ad_var_set_label(Index index, size_t argc, ...) {
 
         Variable *v = state[ad_index];
 
-        if (v->flags & (uint8_t) VariableFlags::FreeLabel)
-            free(v->label);
-
         VarInfo info = jit_set_backend(jit_index);
         const char *prefix = jit_prefix(info.backend);
+        char *value;
         if (!prefix || !label)
-            v->label = label ? strdup(label) : nullptr;
+            value = label ? strdup(label) : nullptr;
         else
-            v->label = concat(prefix, label);
+            value = concat(prefix, label);
 
-        const uint8_t flags = (uint8_t) VariableFlags::FreeLabel |
-                              (uint8_t) VariableFlags::CustomLabel;
+        ad_set_label(ad_index, v, value, label != nullptr);
 
         if (label)
-            v->flags |= flags;
+            v->flags |= (uint8_t) VariableFlags::CustomLabel;
         else
-            v->flags &= ~flags;
+            v->flags &= ~(uint8_t) VariableFlags::CustomLabel;
 
         ad_var_inc_ref_int(ad_index, v);
     }
@@ -1225,6 +1753,131 @@ Index ad_var_set_label(Index index, size_t argc, ...) {
 }
 
 
+// ==========================================================================
+// AD graph compaction
+// ==========================================================================
+
+/**
+ * \brief Try to collapse the chain ``a -> b -> c`` into a single edge
+ * ``a -> c`` and release the interior variable ``b``.
+ *
+ * This is possible when both edges are simple (i.e. they only store a weight),
+ * when ``b`` has no other incident edges, and when nothing else references
+ * ``b`` so that its gradient is unobservable. The composite edge stores the
+ * product of the two weights, which can itself be collapsed again. Hence, a
+ * chain of any length eventually turns into a single edge.
+ *
+ * ``Variable::mul_accum()`` does not propagate zero-valued gradients, even
+ * along edges with an infinite or NaN weight. Along the original chain, the
+ * intermediate gradient at ``b`` is zero when either weight is zero
+ * (depending on the direction of traversal). The product is therefore set to
+ * zero in that case, which prevents ``0 * inf`` from turning into a NaN.
+ */
+static bool ad_collapse(ADIndex bi, Variable *b) {
+    const uint8_t excluded = (uint8_t) VariableFlags::Symbolic |
+                             (uint8_t) VariableFlags::LoopBoundary |
+                             (uint8_t) VariableFlags::CustomOpOutput |
+                             (uint8_t) VariableFlags::CustomLabel;
+
+    if (b->ref_count.load(std::memory_order_relaxed) != 1 ||
+        (b->flags & excluded) || b->grad.valid() ||
+        !b->next_bwd || !b->next_fwd)
+        return false;
+
+    EdgeIndex e1i = b->next_bwd, e2i = b->next_fwd;
+    Edge &e1 = state.edges[e1i], &e2 = state.edges[e2i];
+    EdgeData &d1 = state.edge_data[e1i], &d2 = state.edge_data[e2i];
+
+    // Edges that are part of a todo list may not be modified
+    if (e1.next_bwd || e2.next_fwd || e1.visited || e2.visited ||
+        d1.special || d2.special)
+        return false;
+
+    ADIndex ai = e1.source, ci = e2.target;
+    Variable *a = state[ai], *c = state[ci];
+
+    // Don't handle broadcasting/reductions between differently sized variables
+    if (a->size != b->size || c->size != b->size ||
+        (c->flags & (uint8_t) VariableFlags::Symbolic))
+        return false;
+
+    JitVar weight = d1.weight * d2.weight;
+    if (!jit_var_is_finite_literal(d1.weight.index()) ||
+        !jit_var_is_finite_literal(d2.weight.index())) {
+        JitVar zero = scalar(weight.index(), 0.f);
+        weight = dr::select((d1.weight == zero) | (d2.weight == zero), zero,
+                            weight);
+    }
+
+    ad_log("ad_collapse(): a%u -> a%u -> a%u becomes a%u -> a%u.", ai, bi,
+           ci, ai, ci);
+
+    // Let e2 take the place of e1 in the forward edge list of 'a'
+    e2.source = ai;
+    e2.next_fwd = e1.next_fwd;
+    ad_edge_relink_fwd(ai, a, e1i, e2i);
+    d2.weight = std::move(weight);
+
+    // The reference to 'a' previously held by e1 transfers to e2
+    e1 = Edge { };
+    d1 = EdgeData { };
+    state.unused_edges.push(e1i);
+
+    b->next_bwd = 0;
+    b->next_fwd.store(0, std::memory_order_relaxed);
+    b->ref_count.store(0, std::memory_order_relaxed);
+    ad_free(bi, b);
+
+    return true;
+}
+
+/// Collapse all eligible chains in the AD graph (see \ref ad_collapse())
+static size_t ad_compact_graph_impl() {
+    size_t count = 0;
+
+    for (uint32_t i = 1; i < (uint32_t) state.variables.size(); ++i) {
+        Variable *v = &state.variables[i];
+        if (v->ref_count.load(std::memory_order_relaxed) != 0)
+            count += ad_collapse(i, v);
+    }
+
+    if (count)
+        ad_log("ad_compact_graph(): collapsed %zu variables.", count);
+
+    ad_compact();
+
+    return count;
+}
+
+/// Automatic graph compaction, triggered when the number of variables grows
+static void ad_compact_graph_auto() {
+    size_t used = state.variables.size() - state.unused_variables.size() - 1;
+    if (used < std::max(state.compact_threshold.load(std::memory_order_relaxed),
+                        state.compact_next))
+        return;
+
+    ad_compact_graph_impl();
+
+    // Amortize the cost of scanning the graph
+    used = state.variables.size() - state.unused_variables.size() - 1;
+    state.compact_next = 2 * used;
+}
+
+size_t ad_compact_graph() {
+    if (jit_flag(JitFlag::SymbolicScope))
+        ad_raise("ad_compact_graph(): cannot be used within a symbolic "
+                 "operation!");
+
+    std::lock_guard<std::mutex> guard(state.mutex);
+    return ad_compact_graph_impl();
+}
+
+void ad_set_compact_threshold(size_t size) {
+    std::lock_guard<std::mutex> guard(state.mutex);
+    state.compact_threshold.store(size, std::memory_order_relaxed);
+    state.compact_next = 0;
+}
+
 // ==========================================================================
 // Enqueuing of variables and edges
 // ==========================================================================
@@ -1356,34 +2009,12 @@ static void ad_clear_todo(std::vector<EdgeRef> &todo, bool remove_edges) {
                    er.target);
 
             // Clear out forward edge
-            uint32_t edge_id_prev = 0,
-                     edge_id_cur = source->next_fwd;
-
-            while (edge_id_cur) {
-                Edge &e2 = state.edges[edge_id_cur];
-
-                ad_assert(e2.source == er.source,
-                          "ad_clear_todo(): invalid forward edge connectivity!");
-
-                if (edge_id_cur == er.id) {
-                    if (edge_id_prev)
-                        state.edges[edge_id_prev].next_fwd = e2.next_fwd;
-                    else
-                        source->next_fwd = e2.next_fwd;
-                    break;
-                }
-
-                edge_id_prev = edge_id_cur;
-                edge_id_cur = e2.next_fwd;
-            }
-
-            ad_assert(edge_id_cur,
-                      "ad_clear_todo(): could not find forward edge a%u -> a%u",
-                      er.source, er.target);
+            ad_edge_relink_fwd(er.source, source, er.id,
+                               state.edges[er.id].next_fwd);
 
             // Clear out backward edge
-            edge_id_prev = 0;
-            edge_id_cur = target->next_bwd;
+            uint32_t edge_id_prev = 0,
+                     edge_id_cur = target->next_bwd;
 
             while (edge_id_cur) {
                 Edge &e2 = state.edges[edge_id_cur];
@@ -1407,6 +2038,7 @@ static void ad_clear_todo(std::vector<EdgeRef> &todo, bool remove_edges) {
                       er.source, er.target);
 
             state.edges[er.id] = Edge { };
+            state.edge_data[er.id] = EdgeData { };
             state.unused_edges.push(er.id);
 
             source = state[er.source];
@@ -1420,6 +2052,97 @@ static void ad_clear_todo(std::vector<EdgeRef> &todo, bool remove_edges) {
     todo.clear();
 }
 
+/// Simple edge whose gradient is accumulated by ``ad_accum_parallel()``
+struct ParallelAccum {
+    ADIndex target;
+    ADIndex source;
+    EdgeIndex edge;
+};
+
+/// Number of target vertices processed by a single nanothread work unit
+static constexpr uint32_t ParallelAccumBlockSize = 16;
+
+/**
+ * \brief Propagate gradients along a set of simple edges belonging to the
+ * same dependency level using the nanothread thread pool.
+ *
+ * The ``source`` and ``target`` fields refer to the direction of traversal.
+ * Edges with the same target are handled by the same work unit in the order
+ * given by ``accum``. The accumulation order is therefore deterministic and
+ * independent of the number of threads.
+ *
+ * The caller holds ``state.mutex`` throughout. Worker threads only access
+ * variables referenced by the traversed edges and never modify the graph
+ * structure, hence they do not need to acquire it.
+ */
+static void ad_accum_parallel(std::vector<ParallelAccum> &accum,
+                              bool clear_edges) {
+    if (accum.empty())
+        return;
+
+    std::stable_sort(accum.begin(), accum.end(),
+                     [](const ParallelAccum &a, const ParallelAccum &b) {
+                         return a.target < b.target;
+                     });
+
+    // Offsets of groups of edges with the same target vertex
+    std::vector<uint32_t> groups;
+    for (uint32_t i = 0; i < (uint32_t) accum.size(); ++i) {
+        if (i == 0 || accum[i].target != accum[i - 1].target)
+            groups.push_back(i);
+    }
+    uint32_t group_count = (uint32_t) groups.size();
+    groups.push_back((uint32_t) accum.size());
+
+    auto run = [&](uint32_t group) {
+        Variable *v1 = state.lookup_unlocked(accum[groups[group]].target);
+
+        for (uint32_t i = groups[group]; i < groups[group + 1]; ++i) {
+            const ParallelAccum &a = accum[i];
+            const Variable *v0 = state.lookup_unlocked(a.source);
+            EdgeData &data = state.edge_data[a.edge];
+
+            v1->mul_accum(v0->grad, data.weight, v0->size);
+
+            if (clear_edges)
+                data.weight = JitVar();
+        }
+    };
+
+    // Not worth dispatching to the thread pool
+    if (group_count < 2 * ParallelAccumBlockSize) {
+        for (uint32_t i = 0; i < group_count; ++i)
+            run(i);
+        return;
+    }
+
+    // Worker threads should build expressions with the same JIT flags
+    uint32_t jit_flags_v = jit_flags();
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    dr::parallel_for(
+        dr::blocked_range<uint32_t>(0, group_count, ParallelAccumBlockSize),
+        [&](dr::blocked_range<uint32_t> range) {
+            uint32_t backup = jit_flags();
+            jit_set_flags(jit_flags_v);
+
+            try {
+                for (uint32_t i = range.begin(); i != range.end(); ++i)
+                    run(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+
+            jit_set_flags(backup);
+        });
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
 void ad_traverse(dr::ADMode mode, uint32_t flags) {
     if (mode != dr::ADMode::Forward && mode != dr::ADMode::Backward)
         ad_raise("ad_traverse(): invalid mode specified!");
@@ -1459,6 +2182,34 @@ void ad_traverse(dr::ADMode mode, uint32_t flags) {
 
         tsl::robin_set<uint32_t, UInt32Hasher> pending;
 
+        /* When a memory budget is set, keep track of the estimated size of
+           the gradients that were accumulated since the last evaluation */
+        size_t budget = jit_flag(JitFlag::SymbolicScope) ? 0 : state.memory_budget,
+               unevaluated_size = 0;
+        tsl::robin_set<uint32_t, UInt32Hasher> unevaluated;
+
+        auto eval_pending = [&]() {
+            for (uint32_t todo: pending)
+                jit_var_schedule(state[todo]->grad.index());
+            jit_eval();
+            unevaluated.clear();
+            unevaluated_size = 0;
+        };
+
+        auto account = [&](uint32_t vi, const Variable *v) {
+            if (budget && unevaluated.insert(vi).second)
+                unevaluated_size += v->size * jit_type_size((VarType) v->type);
+        };
+
+        auto enforce_budget = [&]() {
+            if (!budget || unevaluated_size <= budget)
+                return;
+            ad_log("ad_traverse(): evaluating %zu pending gradients (estimated "
+                   "size: %zu bytes, budget: %zu bytes).", pending.size(),
+                   unevaluated_size, budget);
+            eval_pending();
+        };
+
         auto postprocess = [&](uint32_t prev_i, uint32_t cur_i) {
             if (!prev_i || prev_i == cur_i)
                 return;
@@ -1467,6 +2218,9 @@ void ad_traverse(dr::ADMode mode, uint32_t flags) {
             Variable *prev = state[prev_i],
                      *cur = cur_i ? state[cur_i] : nullptr;
 
+            if (budget && unevaluated.erase(prev_i))
+                unevaluated_size -= prev->size * jit_type_size((VarType) prev->type);
+
             /* Wavefront-style evaluation of loops with differentiable
                variables produces dummy nodes with the 'LoopBoundary' flag set
                after each iteration. It's good if we dr::schedule() and then
@@ -1477,15 +2231,14 @@ void ad_traverse(dr::ADMode mode, uint32_t flags) {
                The code below does just that. */
 
             if (prev->flags & (uint8_t) VariableFlags::LoopBoundary &&
-                !(cur && (cur->flags & (uint8_t) VariableFlags::LoopBoundary))) {
-                for (uint32_t todo: pending)
-                    jit_var_schedule(state[todo]->grad.index());
-                jit_eval();
-            }
+                !(cur && (cur->flags & (uint8_t) VariableFlags::LoopBoundary)))
+                eval_pending();
 
             bool clear_grad = false;
             uint32_t next_edge =
-                mode == dr::ADMode::Forward ? prev->next_bwd : prev->next_fwd;
+                mode == dr::ADMode::Forward
+                    ? prev->next_bwd
+                    : prev->next_fwd.load(std::memory_order_relaxed);
 
             if (flags & (uint32_t) dr::ADFlag::ClearInterior)
                 clear_grad |= next_edge != 0;
@@ -1505,14 +2258,15 @@ void ad_traverse(dr::ADMode mode, uint32_t flags) {
             }
         };
 
-        uint32_t v0i_prev = 0;
-
-        // This is the main AD traversal loop
-        for (EdgeRef &er : todo) {
+        /* Look up an edge, determine its endpoints in the direction of
+           traversal, and perform validity checks. Returns 'false' when the
+           edge should be skipped. */
+        auto prepare = [&](EdgeRef &er, uint32_t &v0i, uint32_t &v1i,
+                           Variable *&v0, Variable *&v1) -> bool {
             Edge &edge = state.edges[er.id];
 
-            Variable *v0, *v1;
-            uint32_t v0i = edge.source, v1i = edge.target;
+            v0i = edge.source;
+            v1i = edge.target;
             std::tie(v0, v1) = ad_lookup_edge(er, edge);
 
             if (mode == dr::ADMode::Backward) {
@@ -1529,7 +2283,7 @@ void ad_traverse(dr::ADMode mode, uint32_t flags) {
 
                     ls.scopes.back().postponed.push_back(er);
                     er.id = er.source = er.target = 0;
-                    continue;
+                    return false;
                 } else if (v1->counter < postpone_before) {
                     ad_raise(
                         "ad_traverse(): tried to forward-propagate derivatives "
@@ -1545,20 +2299,21 @@ void ad_traverse(dr::ADMode mode, uint32_t flags) {
                 if (grad_size == 0) {
                     ad_log("ad_traverse(): skipping edge a%u -> a%u (no source "
                            "gradient).", v0i, v1i);
-                    continue;
+                    return false;
                 } else {
                     ad_raise("ad_traverse(): gradient propagation encountered "
                              "variable a%u (\"%s\") with an invalid gradient size "
                              "(expected=%zu, actual=%zu)!",
-                             v0i, v0->label ? v0->label : "", v0->size, grad_size);
+                             v0i, ad_label(v0i) ? ad_label(v0i) : "", v0->size, grad_size);
                 }
             }
 
-            postprocess(v0i_prev, v0i);
-            v0i_prev = v0i;
-
-            pending.insert(v1i);
+            return true;
+        };
 
+        // Propagate the gradient of 'v0' along an edge to 'v1'
+        auto process = [&](const EdgeRef &er, uint32_t v0i, uint32_t v1i,
+                           Variable *v0, Variable *v1) {
             ad_log("ad_traverse(): processing edge a%u -> a%u ..", v0i, v1i);
 
             // Only propagate the label to the gradient if this doesn't require
@@ -1567,35 +2322,130 @@ void ad_traverse(dr::ADMode mode, uint32_t flags) {
             if (unlikely(v0->flags & (uint8_t) VariableFlags::CustomLabel) &&
                 jit_var_ref(v0->grad.index()) == 1) {
                 dr::string tmp;
-                tmp.put(v0->label, " [grad]");
+                tmp.put(ad_label(v0i), " [grad]");
                 if (v0->grad.valid())
                     dr::set_label(v0->grad, tmp.c_str());
             }
 
-            if (unlikely(edge.special)) {
+            // Cold per-edge payload (special callback or weight)
+            EdgeData &data = state.edge_data[er.id];
+
+            if (unlikely(data.special)) {
                 if (mode == dr::ADMode::Forward)
-                    edge.special->forward(v0, v1);
+                    data.special->forward(v0, v1);
                 else
-                    edge.special->backward(v1, v0);
+                    data.special->backward(v1, v0);
 
                 if (clear_edges) {
-                    // Edge may have been invalidated by callback, look up once more
-                    Edge &edge2 = state.edges[er.id];
-
                     // Don't clear ``CopyGrad`` edges, the custom op does this
-                    if (edge2.copy_grad)
-                        continue;
+                    if (state.edges[er.id].copy_grad)
+                        return;
 
-                    edge2.special.reset();
+                    state.edge_data[er.id].special.reset();
                 }
             } else {
-                v1->mul_accum(v0->grad, edge.weight, v0->size);
+                v1->mul_accum(v0->grad, data.weight, v0->size);
 
                 if (clear_edges)
-                    edge.weight = JitVar();
+                    data.weight = JitVar();
             }
-        }
+        };
+
+        uint32_t v0i_prev = 0;
+
+        /* The parallel traversal mode builds gradient expressions on worker
+           threads. JIT state related to symbolic operations (masks, scopes)
+           is thread-local, hence this is only done outside of them. */
+        bool parallel = (flags & (uint32_t) dr::ADFlag::ParallelTraversal) &&
+                        !jit_flag(JitFlag::SymbolicScope) && todo.size() > 1;
+
+        if (!parallel) {
+            // This is the main AD traversal loop
+            for (EdgeRef &er : todo) {
+                Variable *v0, *v1;
+                uint32_t v0i, v1i;
+
+                if (!prepare(er, v0i, v1i, v0, v1))
+                    continue;
+
+                postprocess(v0i_prev, v0i);
+                v0i_prev = v0i;
+
+                pending.insert(v1i);
+                process(er, v0i, v1i, v0, v1);
+
+                account(v1i, v1);
+                enforce_budget();
+            }
+        } else {
+            /* Assign each edge to a dependency level. The edges are already
+               sorted topologically, hence the level of the source vertex is
+               final by the time that its outgoing edges are encountered. */
+            tsl::robin_map<uint32_t, uint32_t, UInt32Hasher> vertex_level;
+            std::vector<uint32_t> edge_level(todo.size()),
+                                  order(todo.size());
+
+            for (size_t i = 0; i < todo.size(); ++i) {
+                const EdgeRef &er = todo[i];
+                uint32_t v0i = er.source, v1i = er.target;
+                if (mode == dr::ADMode::Backward)
+                    std::swap(v0i, v1i);
+
+                auto it = vertex_level.find(v0i);
+                uint32_t level = it == vertex_level.end() ? 0 : it->second;
+                uint32_t &level_1 = vertex_level[v1i];
+                level_1 = std::max(level_1, level + 1);
+
+                edge_level[i] = level;
+                order[i] = (uint32_t) i;
+            }
+
+            // Group edges by level while preserving the order within levels
+            std::stable_sort(order.begin(), order.end(),
+                             [&](uint32_t a, uint32_t b) {
+                                 return edge_level[a] < edge_level[b];
+                             });
+
+            std::vector<ParallelAccum> accum;
+            std::vector<uint32_t> done;
+
+            for (size_t i = 0; i < order.size(); ) {
+                uint32_t level = edge_level[order[i]];
+                accum.clear();
+                done.clear();
+
+                /* Validate edges on the main thread and process special edges
+                   right away. They may invoke arbitrary (e.g., Python) code. */
+                for (; i < order.size() && edge_level[order[i]] == level; ++i) {
+                    EdgeRef &er = todo[order[i]];
+                    Variable *v0, *v1;
+                    uint32_t v0i, v1i;
 
+                    if (!prepare(er, v0i, v1i, v0, v1))
+                        continue;
+
+                    if (done.empty() || done.back() != v0i)
+                        done.push_back(v0i);
+                    pending.insert(v1i);
+                    account(v1i, v1);
+
+                    if (state.edge_data[er.id].special)
+                        process(er, v0i, v1i, v0, v1);
+                    else
+                        accum.push_back({ v1i, v0i, er.id });
+                }
+
+                ad_log("ad_traverse(): level %u: accumulating %zu edges in "
+                       "parallel.", level, accum.size());
+                ad_accum_parallel(accum, clear_edges);
+                enforce_budget();
+
+                for (uint32_t v0i : done) {
+                    postprocess(v0i_prev, v0i);
+                    v0i_prev = v0i;
+                }
+            }
+        }
 
         postprocess(v0i_prev, 0);
         ad_log("ad_traverse(): done.");
@@ -1606,10 +2456,24 @@ void ad_traverse(dr::ADMode mode, uint32_t flags) {
 
     ad_clear_todo(todo, clear_edges);
 
+    // Removing edges may have freed a large part of the graph
+    if (clear_edges)
+        ad_compact();
+
     if (todo_tls.empty())
         todo_tls.swap(todo);
 }
 
+void ad_set_memory_budget(size_t size) {
+    std::lock_guard<std::mutex> guard(state.mutex);
+    state.memory_budget = size;
+}
+
+size_t ad_memory_budget() {
+    std::lock_guard<std::mutex> guard(state.mutex);
+    return state.memory_budget;
+}
+
 // ==========================================================================
 // AD scope management
 // ==========================================================================
@@ -2150,13 +3014,9 @@ Index ad_var_new(JitIndex i0) {
         std::lock_guard<std::mutex> guard(state.mutex);
         Variable *v = state[ad_index(result)];
 
-        if (!prefix || !label)
-            v->label = label ? strdup(label) : nullptr;
-        else
-            v->label = concat(prefix, label);
-
-        v->flags |= (uint8_t) VariableFlags::FreeLabel |
-                    (uint8_t) VariableFlags::CustomLabel;
+        ad_set_label(ad_index(result), v,
+                     prefix ? concat(prefix, label) : strdup(label), true);
+        v->flags |= (uint8_t) VariableFlags::CustomLabel;
     }
 
     return result;
@@ -3333,8 +4193,9 @@ const char *ad_var_whos() {
                "  =========================================================\n");
     for (uint32_t id : indices) {
         const Variable *v = state[id];
+        const char *label = ad_label(id);
         buffer.fmt("  %-9i %-3s %12zu %8u    %s\n", id, type_name_short[v->type],
-                   v->size, v->ref_count, v->label ? v->label : "");
+                   v->size, v->ref_count.load(), label ? label : "");
     }
     buffer.put("  =========================================================\n");
     return buffer.get();
@@ -3366,7 +4227,7 @@ const char *ad_var_graphviz() {
 
     for (uint32_t index : indices) {
         const Variable *v = state[index];
-        const char *label = v->label,
+        const char *label = ad_label(index),
                    *label_without_prefix = label;
 
         size_t prefix_hash = 0;
@@ -3502,10 +4363,10 @@ const char *ad_var_graphviz() {
             const Edge &e = state.edges[edge];
             if (edge_count == 1)
                 buffer.fmt("    %i -> %i%s;\n", e.target, e.source,
-                           e.special ? " [color=red]" : "");
+                           state.edge_data[edge].special ? " [color=red]" : "");
             else
                 buffer.fmt("    %i -> %i [label=\" %u\"%s];\n", e.target, e.source,
-                           edge_ctr--, e.special ? " color=red" : "");
+                           edge_ctr--, state.edge_data[edge].special ? " color=red" : "");
             edge = e.next_bwd;
         }
     }
@@ -3605,11 +4466,11 @@ uint32_t ad_record_implicit_dependence(LocalState &ls, ReleaseHelper &rh,
     Edge &edge = state.edges[edge_index_new];
     edge.source = source;
     edge.target = ad_index;
-    edge.next_fwd = v_source->next_fwd;
-    v->next_bwd = edge_index_new;
-    v_source->next_fwd = edge_index_new;
     edge.next_bwd = 0;
-    edge.special = dr::make_unique<Gather>(GenericArray<uint32_t>(0), JitMask(true));
+    v->next_bwd = edge_index_new;
+    state.edge_data[edge_index_new].special =
+        dr::make_unique<Gather>(GenericArray<uint32_t>(0), JitMask(true));
+    ad_edge_push_fwd(v_source, edge_index_new);
     ad_var_inc_ref_int(source, v_source);
     ad_log(
         "ad_var_new(): a%u = gather(a%u) [converted from scalar read].",
@@ -3736,9 +4597,9 @@ struct CustomOp : Special {
         }
     }
 
-    bool swap(const Edge &e, Variable *v) {
+    bool swap(EdgeIndex ei, const Edge &e, Variable *v) {
         if (e.copy_grad) {
-            CopyGrad &copy_grad = *(CopyGrad *) e.special.get();
+            CopyGrad &copy_grad = *(CopyGrad *) state.edge_data[ei].special.get();
             std::swap(copy_grad.grad, v->grad);
             return true;
         } else {
@@ -3746,9 +4607,9 @@ struct CustomOp : Special {
         }
     }
 
-    bool clear(const Edge &e, Variable *v) {
+    bool clear(EdgeIndex ei, const Edge &e, Variable *v) {
         if (e.copy_grad) {
-            CopyGrad &copy_grad = *(CopyGrad *) e.special.get();
+            CopyGrad &copy_grad = *(CopyGrad *) state.edge_data[ei].special.get();
             v->grad = copy_grad.grad;
             copy_grad.grad = JitVar();
             return true;
@@ -3775,7 +4636,7 @@ struct CustomOp : Special {
 
         for (uint32_t ei = next_bwd; ei != 0; ) {
             const Edge &e = state.edges[ei];
-            if (!swap(e, state[e.source]))
+            if (!swap(ei, e, state[e.source]))
                 break;
             ei = e.next_bwd;
         }
@@ -3788,12 +4649,12 @@ struct CustomOp : Special {
         }
 
         #if defined(DRJIT_SANITIZE_INTENSE)
-            ad_sanitation_checkpoint_both();
+            ad_sanitation_checkpoint();
         #endif
 
         for (uint32_t ei = next_bwd; ei != 0; ) {
             const Edge &e = state.edges[ei];
-            if (!clear(e, state[e.source]))
+            if (!clear(ei, e, state[e.source]))
                 break;
             ei = e.next_bwd;
         }
@@ -3807,7 +4668,7 @@ struct CustomOp : Special {
 
         for (uint32_t ei = next_fwd; ei; ) {
             const Edge &e = state.edges[ei];
-            if (!swap(e, state[e.target]))
+            if (!swap(ei, e, state[e.target]))
                 break;
             ei = e.next_fwd;
         }
@@ -3820,12 +4681,12 @@ struct CustomOp : Special {
         }
 
         #if defined(DRJIT_SANITIZE_INTENSE)
-            ad_sanitation_checkpoint_both();
+            ad_sanitation_checkpoint();
         #endif
 
         for (uint32_t ei = next_fwd; ei; ) {
             const Edge &e = state.edges[ei];
-            if (!clear(e, state[e.target]))
+            if (!clear(ei, e, state[e.target]))
                 break;
             ei = e.next_fwd;
         }
@@ -3845,27 +4706,26 @@ void ad_add_special(uint32_t v0i, uint32_t v1i, bool is_custom,
     Edge &edge = state.edges[edge_index_new];
     edge.source = v0i;
     edge.target = v1i;
-    edge.special = std::move(special);
+    state.edge_data[edge_index_new].special = std::move(special);
     edge.copy_grad = !is_custom;
     edge.is_custom = is_custom;
 
-    edge.next_fwd = v0->next_fwd;
     edge.next_bwd = v1->next_bwd;
-
-    v0->next_fwd = edge_index_new;
     v1->next_bwd = edge_index_new;
+    ad_edge_push_fwd(v0, edge_index_new);
 
     ad_var_inc_ref_int(v0i, v0);
 }
 
 static Variable *ad_custom_output_create(uint32_t index, Variable *v) {
-    bool is_scatter = v->label && strncmp(v->label, "scatter", 7) == 0;
+    const char *label = ad_label(index);
+    bool is_scatter = label && strncmp(label, "scatter", 7) == 0;
 
     // References should be held by: caller & CustomOp (2x)
     // Side effects can have a higher refcount
     ad_assert(v->ref_count == 3 || is_scatter,
               "ad_custom_op(): invalid reference count %u in variable a%u",
-              v->ref_count, index);
+              v->ref_count.load(), index);
 
     v->flags |= VariableFlags::CustomOpOutput;
 
@@ -3873,7 +4733,7 @@ static Variable *ad_custom_output_create(uint32_t index, Variable *v) {
         return v;
 
     // From implicit outputs, remove any prior computation traced within the CustomOp
-    v->counter = state.counter++;
+    v->counter = state.counter.fetch_add(1, std::memory_order_relaxed);
     ad_free_edges(index, v);
     return state[index];
 }
@@ -3975,17 +4835,9 @@ bool ad_custom_op(dr::detail::CustomOpBase *op) {
 
     Variable *v0 = state[v0i], *v1 = state[v1i];
 
-    if (v1->flags & (uint8_t) VariableFlags::FreeLabel)
-        free(v1->label);
-
     const char *prefix = jit_prefix(op->m_backend);
-    if (!prefix)
-        v1->label = strdup(name);
-    else
-        v1->label = concat(prefix, name);
-
-    v1->flags |= (uint8_t) VariableFlags::FreeLabel |
-                 (uint8_t) VariableFlags::CustomLabel;
+    ad_set_label(v1i, v1, prefix ? concat(prefix, name) : strdup(name), true);
+    v1->flags |= (uint8_t) VariableFlags::CustomLabel;
 
     ad_var_dec_ref_int(v0i, v0);
     ad_var_dec_ref_int(v1i, v1);
@@ -4002,7 +4854,7 @@ static bool DRJIT_NOINLINE ad_decref_custom_op_output(Variable *v) {
     if (v->ref_count != 2 || !next_bwd)
         return false;
 
-    Edge *edge = &state.edges[v->next_bwd];
+    Edge *edge = &state.edges[next_bwd];
     if (edge->copy_grad) {
         next_bwd = state[edge->source]->next_bwd;
         if (!next_bwd)
@@ -4010,15 +4862,17 @@ static bool DRJIT_NOINLINE ad_decref_custom_op_output(Variable *v) {
         edge = &state.edges[next_bwd];
     }
 
+    Special *special = state.edge_data[next_bwd].special.get();
+
     ad_assert(edge->is_custom, "ad_decref_custom_op_output(): expected to "
                                "find an edge representing a CustomOp!");
 
-    if (!edge->special)
+    if (!special)
         return false;
 
     size_t counter = v->counter;
 
-    ((CustomOp *) edge->special.get())->release_one_output();
+    ((CustomOp *) special)->release_one_output();
 
     // CustomOp may have been destroyed so check again if output was also freed
     // or reused in the meantime
@@ -4032,8 +4886,7 @@ NAMESPACE_BEGIN(detail)
 CustomOpBase::CustomOpBase() {
     std::lock_guard<std::mutex> guard(state.mutex);
     m_backend = JitBackend::None;
-    m_counter_offset = state.counter;
-    state.counter += 2;
+    m_counter_offset = state.counter.fetch_add(2, std::memory_order_relaxed);
 }
 
 CustomOpBase::~CustomOpBase() {
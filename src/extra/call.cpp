@@ -15,7 +15,11 @@
 #include <drjit/autodiff.h>
 #include <drjit/custom.h>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <vector>
+#include <cstring>
 #include "common.h"
 
 namespace dr = drjit;
@@ -57,6 +61,156 @@ private:
 
 using JitVar = GenericArray<void>;
 
+/// Sort the entries of symbolic calls by callee? (see ad_call_set_sort_by_callee())
+static std::atomic<bool> call_sort_by_callee { false };
+
+/// Set while ad_call() dispatches a call with sorted entries
+static thread_local bool call_sorted = false;
+
+/// Launch the kernels of evaluated calls in one batch? (see ad_call_set_batched())
+static std::atomic<bool> call_batched { false };
+
+/// Bucket size below which evaluated calls dispatch symbolically (0: disabled)
+static std::atomic<size_t> call_small_bucket_threshold { 0 };
+
+/// Inline the callee of uniform calls? (see ad_call_set_devirtualize())
+static std::atomic<bool> call_devirtualize { false };
+
+/// Devirtualized calls recorded while the kernel history is enabled
+static std::vector<CallHistoryEntry> call_history;
+static std::mutex call_history_mutex;
+
+void ad_call_set_sort_by_callee(bool value) {
+    call_sort_by_callee.store(value, std::memory_order_relaxed);
+}
+
+bool ad_call_sort_by_callee() {
+    return call_sort_by_callee.load(std::memory_order_relaxed);
+}
+
+void ad_call_set_batched(bool value) {
+    call_batched.store(value, std::memory_order_relaxed);
+}
+
+bool ad_call_batched() {
+    return call_batched.load(std::memory_order_relaxed);
+}
+
+void ad_call_set_small_bucket_threshold(size_t value) {
+    call_small_bucket_threshold.store(value, std::memory_order_relaxed);
+}
+
+size_t ad_call_small_bucket_threshold() {
+    return call_small_bucket_threshold.load(std::memory_order_relaxed);
+}
+
+void ad_call_set_devirtualize(bool value) {
+    call_devirtualize.store(value, std::memory_order_relaxed);
+}
+
+bool ad_call_devirtualize() {
+    return call_devirtualize.load(std::memory_order_relaxed);
+}
+
+CallHistoryEntry *ad_call_history() {
+    std::lock_guard<std::mutex> guard(call_history_mutex);
+    CallHistoryEntry *result = (CallHistoryEntry *) calloc(
+        call_history.size() + 1, sizeof(CallHistoryEntry));
+    if (!call_history.empty())
+        memcpy(result, call_history.data(),
+               call_history.size() * sizeof(CallHistoryEntry));
+    call_history.clear();
+    return result;
+}
+
+void ad_call_history_clear() {
+    std::lock_guard<std::mutex> guard(call_history_mutex);
+    for (CallHistoryEntry &entry : call_history)
+        free(entry.name);
+    call_history.clear();
+}
+
+/**
+ * Check if all active entries of a vectorized call target the same instance,
+ * and return its ID (or zero otherwise). This is trivial for literal indices.
+ * Indices that are already evaluated are checked using two reductions. The
+ * check is skipped for unevaluated indices, since evaluating them just for
+ * this purpose would launch an extra kernel on every call.
+ */
+static uint32_t ad_call_uniform(JitBackend backend, uint32_t index,
+                                uint32_t mask) {
+    uint32_t result = 0;
+
+    if (jit_var_state(index) == VarState::Literal) {
+        jit_var_read(index, 0, &result);
+        return result;
+    }
+
+    if (jit_var_state(index) != VarState::Evaluated ||
+        jit_flag(JitFlag::SymbolicScope))
+        return 0;
+
+    JitVar lo = JitVar::borrow(index), hi = JitVar::borrow(index);
+    if (mask) {
+        // Ignore inactive entries
+        JitVar zero = JitVar::steal(jit_var_u32(backend, 0)),
+               ones = JitVar::steal(jit_var_u32(backend, 0xFFFFFFFFu));
+        lo = JitVar::steal(jit_var_select(mask, index, ones.index()));
+        hi = JitVar::steal(jit_var_select(mask, index, zero.index()));
+    }
+
+    JitVar min = JitVar::steal(jit_var_reduce(backend, VarType::UInt32,
+                                              ReduceOp::Min, lo.index())),
+           max = JitVar::steal(jit_var_reduce(backend, VarType::UInt32,
+                                              ReduceOp::Max, hi.index()));
+
+    uint32_t min_v = 0, max_v = 0;
+    jit_var_read(min.index(), 0, &min_v);
+    jit_var_read(max.index(), 0, &max_v);
+
+    return min_v == max_v ? min_v : 0;
+}
+
+/**
+ * Compute a permutation that groups the entries of a vectorized call by
+ * callee using a counting sort over the instance IDs. On return, ``perm``
+ * lists the entries in sorted order, and ``pos`` specifies the position of
+ * each entry within this order (i.e., the inverse permutation).
+ */
+static void ad_call_sort(JitBackend backend, size_t size, uint32_t index,
+                         size_t callable_count, JitVar &perm, JitVar &pos) {
+    uint32_t zero = 0;
+    JitVar true_mask = JitVar::steal(jit_var_bool(backend, true)),
+           bound = JitVar::steal(jit_var_u32(backend, (uint32_t) callable_count)),
+           bucket = JitVar::steal(jit_var_min(index, bound.index()));
+
+    if (bucket.size() != size)
+        bucket.resize(size);
+
+    // Count the number of entries per callee, and the rank within each bucket
+    uint32_t counts_i = jit_var_literal(backend, VarType::UInt32, &zero,
+                                        callable_count + 1);
+    JitVar rank = JitVar::steal(
+        jit_var_scatter_inc(&counts_i, bucket.index(), true_mask.index()));
+    JitVar counts = JitVar::steal(counts_i);
+
+    // Offset of each bucket in the sorted order
+    JitVar offset = JitVar::steal(jit_var_prefix_sum(counts.index(), 1)),
+           base = JitVar::steal(jit_var_gather(offset.index(), bucket.index(),
+                                               true_mask.index()));
+
+    pos = JitVar::steal(jit_var_add(base.index(), rank.index()));
+
+    JitVar buffer = JitVar::steal(jit_var_undefined(backend, VarType::UInt32, size)),
+           counter = JitVar::steal(jit_var_counter(backend, size));
+    perm = JitVar::steal(jit_var_scatter(buffer.index(), counter.index(),
+                                         pos.index(), true_mask.index(),
+                                         ReduceOp::Identity, ReduceMode::Permute));
+
+    jit_var_schedule(pos.index());
+    jit_var_schedule(perm.index());
+}
+
 // Forward declaration of a helper function full of checks (used by all strategies)
 static void ad_call_check_rv(JitBackend backend, size_t size,
                              size_t callable_index,
@@ -364,13 +518,16 @@ static void ad_call_symbolic(JitBackend backend, const char *domain,
     jit_new_scope(backend);
 }
 
-// Strategy 3: group the arguments and evaluate a kernel per callable
-static void ad_call_reduce(JitBackend backend, const char *domain,
+// Strategy 3: group the arguments and evaluate a kernel per callable. Returns
+// \c false if a nested symbolic call took ownership of 'payload'.
+static bool ad_call_reduce(JitBackend backend, const char *domain,
                             const char *name, size_t size, uint32_t index_,
                             uint32_t mask_, size_t callable_count,
+                            size_t callable_count_in,
                             const vector<uint64_t> args_,
                             vector<uint64_t> &rv,
-                            ad_call_func func, void *payload) {
+                            ad_call_func func, void *payload,
+                            ad_call_cleanup &cleanup, bool ad) {
     (void) name; // unused
     const char *domain_or_empty = domain ? domain : "",
                *separator = domain ? "::" : "";
@@ -417,8 +574,110 @@ static void ad_call_reduce(JitBackend backend, const char *domain,
     size_t last_size = 0;
     JitVar memop_mask = JitVar::steal(jit_var_bool(backend, true));
 
+    /* In batched mode, the return values of all instances are only merged
+       once every instance has been traced. A single jit_eval() then launches
+       the kernels of all instances at once, instead of one after the other. */
+    bool batched = ad_call_batched();
+    index32_vector pending_index;
+    index64_vector pending_rv;
+
+    /* Buckets with few entries still cause a full round of argument gathers,
+       tracing, a kernel launch, and a scatter. When there are several such
+       buckets, merge them into a single symbolic call over their entries. */
+    bool done = true;
+    vector<bool> small;
+    size_t threshold = ad_call_small_bucket_threshold();
+
+    if (threshold) {
+        size_t small_count = 0;
+        uint32_t id_bound = 0, first_small = 0;
+
+        small.resize(n_inst, false);
+        for (size_t i = 0; i < n_inst; ++i) {
+            // The table below is indexed by the IDs of all entries
+            id_bound = std::max(id_bound, buckets[i].id);
+            if (buckets[i].id == 0 ||
+                jit_var_size(buckets[i].index) >= threshold)
+                continue;
+            if (!small_count)
+                first_small = buckets[i].id;
+            small[i] = true;
+            small_count++;
+        }
+
+        if (small_count < 2) {
+            small.clear();
+        } else {
+            // Determine which entries belong to a small bucket
+            vector<uint32_t> table(id_bound + 1, 0);
+            for (size_t i = 0; i < n_inst; ++i) {
+                if (small[i])
+                    table[buckets[i].id] = 1;
+            }
+
+            JitVar table_v = JitVar::steal(
+                       jit_var_mem_copy(backend, AllocType::Host, VarType::UInt32,
+                                        table.data(), table.size())),
+                   zero = JitVar::steal(jit_var_u32(backend, 0)),
+                   is_small = JitVar::steal(jit_var_gather(
+                       table_v.index(), index.index(), memop_mask.index())),
+                   small_mask = JitVar::steal(
+                       jit_var_neq(is_small.index(), zero.index())),
+                   lanes = JitVar::steal(jit_var_compress(small_mask.index()));
+
+            size_t small_size = lanes.size();
+            jit_log(LogLevel::InfoSym,
+                    "ad_call_reduce(\"%s%s%s\"): merging %zu small buckets "
+                    "with %zu entries into a symbolic call.", domain_or_empty,
+                    separator, name, small_count, small_size);
+
+            scoped_set_mask mask_guard(
+                backend, jit_var_mask_default(backend, small_size));
+
+            JitVar index_s = JitVar::steal(jit_var_gather(
+                index.index(), lanes.index(), memop_mask.index()));
+
+            index64_vector args_s, rv_s;
+            args_s.reserve(args.size());
+            for (uint64_t arg_i : args) {
+                if (jit_var_size((uint32_t) arg_i) == 1)
+                    args_s.push_back_borrow(arg_i);
+                else
+                    args_s.push_back_steal(ad_var_gather(
+                        arg_i, lanes.index(), memop_mask.index(),
+                        ReduceMode::Auto));
+            }
+
+            try {
+                done = ad_call(backend, domain, 1, callable_count_in, name,
+                               false, (uint32_t) index_s.index(), 0, args_s,
+                               rv_s, payload, func, cleanup, ad);
+            } catch (...) {
+                cleanup = nullptr; // already done by the nested call
+                throw;
+            }
+
+            // A 'CallOp' now owns the payload, don't clean it up on failure
+            if (!done)
+                cleanup = nullptr;
+
+            // Merge the return values of the symbolic call into 'rv'
+            ad_call_check_rv(backend, size, first_small - 1, rv, rv_s);
+            for (size_t j = 0; j < rv_s.size(); ++j) {
+                uint64_t r =
+                    ad_var_scatter(rv[j], rv_s[j], lanes.index(),
+                                   memop_mask.index(), ReduceOp::Identity,
+                                   ReduceMode::Permute);
+                ad_var_dec_ref(rv[j]);
+                rv[j] = r;
+            }
+
+            rv_initialized = true;
+        }
+    }
+
     for (size_t i = 0; i < n_inst; ++i) {
-        if (buckets[i].id == 0)
+        if (buckets[i].id == 0 || (!small.empty() && small[i]))
             continue;
 
         rv_initialized = true;
@@ -430,7 +689,7 @@ static void ad_call_reduce(JitBackend backend, const char *domain,
 
         // Don't merge subsequent wavefronts into the same kernel,
         // which could happen if they have the same size
-        if (last_size == wavefront_size)
+        if (!batched && last_size == wavefront_size)
             jit_eval();
         last_size = wavefront_size;
 
@@ -466,18 +725,51 @@ static void ad_call_reduce(JitBackend backend, const char *domain,
         // Perform some sanity checks on the return values
         ad_call_check_rv(backend, size, i, rv, rv2);
 
-        // Merge 'rv2' into 'rv' (main function return values)
-        for (size_t j = 0; j < rv2.size(); ++j) {
-            uint64_t r =
-                ad_var_scatter(rv[j], rv2[j], index2, memop_mask.index(),
-                               ReduceOp::Identity, ReduceMode::Permute);
-            ad_var_dec_ref(rv[j]);
-            rv[j] = r;
+        if (batched) {
+            // Postpone the merge, but compute the return values in the batch
+            pending_index.push_back_borrow(index2);
+            for (uint64_t r : rv2) {
+                jit_var_schedule((uint32_t) r);
+                pending_rv.push_back_borrow(r);
+            }
+        } else {
+            // Merge 'rv2' into 'rv' (main function return values)
+            for (size_t j = 0; j < rv2.size(); ++j) {
+                uint64_t r =
+                    ad_var_scatter(rv[j], rv2[j], index2, memop_mask.index(),
+                                   ReduceOp::Identity, ReduceMode::Permute);
+                ad_var_dec_ref(rv[j]);
+                rv[j] = r;
+            }
         }
 
         args2.release();
     }
 
+    if (!pending_index.empty()) {
+        // Launch the kernels of all instances
+        jit_eval();
+
+        // Merge the return values of all instances into 'rv'
+        size_t rv_count = rv.size();
+        for (size_t i = 0; i < pending_index.size(); ++i) {
+            uint32_t index2 = pending_index[i];
+            scoped_set_mask mask_guard(
+                backend, jit_var_mask_default(backend, jit_var_size(index2)));
+
+            for (size_t j = 0; j < rv_count; ++j) {
+                uint64_t r = ad_var_scatter(
+                    rv[j], pending_rv[i * rv_count + j], index2,
+                    memop_mask.index(), ReduceOp::Identity, ReduceMode::Permute);
+                ad_var_dec_ref(rv[j]);
+                rv[j] = r;
+            }
+        }
+
+        pending_rv.release();
+        pending_index.release();
+    }
+
     // All targets were fully masked, let's zero-initialize the return value
     if (!rv_initialized) {
         {
@@ -497,6 +789,8 @@ static void ad_call_reduce(JitBackend backend, const char *domain,
 
     for (uint64_t r : rv)
         jit_var_schedule((uint32_t) r);
+
+    return done;
 }
 
 // Helper function full of checks (used by all strategies)
@@ -806,6 +1100,7 @@ bool ad_call(JitBackend backend, const char *domain, int symbolic,
         if (symbolic != 0 && symbolic != 1)
             jit_raise("ad_call(): 'symbolic' must be -1, 0, or 1!");
 
+        size_t callable_count_in = callable_count;
         if (domain)
             callable_count = jit_registry_id_bound(backend, domain);
 
@@ -853,8 +1148,134 @@ bool ad_call(JitBackend backend, const char *domain, int symbolic,
             return true;
         }
 
+        /* Inline the callee when all active entries target the same
+           instance. The callee then directly records its operations
+           (including their derivatives) without a dispatch table. */
+        if (ad && !is_getter && ad_call_devirtualize()) {
+            uint32_t inst = ad_call_uniform(backend, index, mask);
+            void *ptr = nullptr;
+            bool found = false;
+
+            if (inst && domain) {
+                ptr = jit_registry_ptr(backend, domain, inst);
+                found = ptr != nullptr;
+            } else if (inst && inst <= callable_count) {
+                ptr = (void *) (uintptr_t) (inst - 1);
+                found = true;
+            }
+
+            if (found) {
+                jit_log(LogLevel::InfoSym,
+                        "ad_call(\"%s%s%s\"): all entries target instance %u, "
+                        "inlining the callee.", domain_or_empty, separator,
+                        name, inst);
+
+                if (jit_flag(JitFlag::KernelHistory)) {
+                    std::string combined(name);
+                    if (domain)
+                        combined = std::string(domain) + "::" + combined;
+
+                    std::lock_guard<std::mutex> guard(call_history_mutex);
+                    call_history.push_back({ backend, inst, size,
+                                             strdup(combined.c_str()) });
+                }
+
+                JitVar mask_v;
+                if (mask)
+                    mask_v = JitVar::borrow(mask);
+                else
+                    mask_v = JitVar::steal(jit_var_bool(backend, true));
+
+                JitVar active = JitVar::steal(
+                           jit_var_mask_apply(mask_v.index(), (uint32_t) size)),
+                       instance_id = JitVar::steal(jit_var_u32(backend, inst));
+
+                vector<uint64_t> rv2;
+                {
+                    scoped_set_mask mask_guard(
+                        backend, jit_var_mask_apply(mask_v.index(), (uint32_t) size));
+                    scoped_set_self set_self(backend, inst, instance_id.index());
+                    func(payload, ptr, args, rv2);
+                }
+
+                ad_call_check_rv(backend, size, inst - 1, rv, rv2);
+
+                // Inactive entries produce zero-valued return values
+                for (size_t i = 0; i < rv2.size(); ++i) {
+                    uint64_t r = ad_var_select(active.index(), rv2[i], rv[i]);
+                    ad_var_dec_ref(rv[i]);
+                    rv[i] = r;
+                }
+
+                return true;
+            }
+        }
+
+        /* Optionally group the entries by callee before dispatching a
+           symbolic call so that neighboring SIMD lanes/threads run the same
+           code and access related data. The permutation is applied using
+           differentiable gathers, hence the AD graph (including the 'CallOp'
+           created by the nested ad_call()) sees a consistent computation.
+           Derivative propagation via 'CallOp' (ad == false) reuses the
+           already sorted entries. */
+        if (symbolic && ad && !is_getter && !call_sorted && size > 1 &&
+            callable_count > 1 && ad_call_sort_by_callee() &&
+            !jit_flag(JitFlag::SymbolicScope)) {
+            JitVar perm, pos,
+                   true_mask = JitVar::steal(jit_var_bool(backend, true));
+            ad_call_sort(backend, size, index, callable_count, perm, pos);
+
+            JitVar index_s = JitVar::steal(
+                jit_var_gather(index, perm.index(), true_mask.index())),
+                   mask_s;
+            if (mask)
+                mask_s = JitVar::steal(
+                    jit_var_gather(mask, perm.index(), true_mask.index()));
+
+            index64_vector args_s;
+            args_s.reserve(args.size());
+            for (uint64_t arg_i : args) {
+                if (jit_var_size((uint32_t) arg_i) == 1)
+                    args_s.push_back_borrow(arg_i);
+                else
+                    args_s.push_back_steal(ad_var_gather(
+                        arg_i, perm.index(), true_mask.index(), ReduceMode::Auto));
+            }
+
+            jit_log(LogLevel::InfoSym,
+                    "ad_call(\"%s%s%s\"): sorting %zu entries by callee.",
+                    domain_or_empty, separator, name, size);
+
+            bool done;
+            call_sorted = true;
+            try {
+                done = ad_call(backend, domain, 1, callable_count_in, name,
+                               false, (uint32_t) index_s.index(),
+                               (uint32_t) mask_s.index(), args_s, rv, payload,
+                               func, cleanup, ad);
+            } catch (...) {
+                call_sorted = false;
+                cleanup = nullptr; // already done by the nested call
+                throw;
+            }
+            call_sorted = false;
+
+            // Undo the permutation
+            for (uint64_t &r : rv) {
+                if (!r)
+                    continue;
+                uint64_t r2 = ad_var_gather(r, pos.index(), true_mask.index(),
+                                            ReduceMode::Auto);
+                ad_var_dec_ref(r);
+                r = r2;
+            }
+
+            return done;
+        }
+
         vector<bool> rv_ad;
         dr::detail::ad_index32_vector implicit_in;
+        bool done = true;
 
         if (is_getter) {
             ad_call_getter(backend, domain, name, size, index, mask,
@@ -873,8 +1294,9 @@ bool ad_call(JitBackend backend, const char *domain, int symbolic,
                     "documentation of drjit.JitFlag.SymbolicCalls and drjit.switch() for general\n"
                     "information on symbolic and evaluated calls, as well as their limitations.");
 
-            ad_call_reduce(backend, domain, name, size, index, mask,
-                           callable_count, args, rv, func, payload);
+            done = ad_call_reduce(backend, domain, name, size, index, mask,
+                                  callable_count, callable_count_in, args, rv,
+                                  func, payload, cleanup, ad);
             ad = false; // derivative already tracked, no CustomOp needed
         }
 
@@ -928,8 +1350,9 @@ bool ad_call(JitBackend backend, const char *domain, int symbolic,
             }
         }
 
-        // Caller should directly call cleanup()
-        return true;
+        // Caller should directly call cleanup() unless a nested call took
+        // ownership of the payload
+        return done;
     } catch (...) {
         if (cleanup)
             cleanup(payload);
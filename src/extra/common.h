@@ -57,6 +57,15 @@ struct scoped_isolation_boundary {
     bool success = false;
 };
 
+/// RAII helper to temporarily suspend derivative tracking
+struct scoped_suspend_grad {
+    scoped_suspend_grad() {
+        ad_scope_enter(drjit::ADScope::Suspend, 0, nullptr);
+    }
+
+    ~scoped_suspend_grad() { ad_scope_leave(true); }
+};
+
 /// RAII helper to temporarily push a mask onto the Dr.Jit mask stack
 struct scoped_push_mask {
     scoped_push_mask(JitBackend backend, uint32_t index) : backend(backend) {
@@ -18,11 +18,103 @@
 #include <drjit-core/hash.h>
 #include <tsl/robin_map.h>
 #include <tsl/robin_set.h>
+#include <atomic>
 
 namespace dr = drjit;
 
 using JitVar = GenericArray<void>;
 
+/// Minimum size of evaluated conditionals that compact their branches (0: disabled)
+static std::atomic<size_t> cond_compact_threshold { 0 };
+
+void ad_cond_set_compact_threshold(size_t value) {
+    cond_compact_threshold.store(value, std::memory_order_relaxed);
+}
+
+size_t ad_cond_compact_threshold() {
+    return cond_compact_threshold.load(std::memory_order_relaxed);
+}
+
+/**
+ * Try to run one branch of an evaluated conditional on the subset of entries
+ * where ``cond`` is active. Arguments are compacted using differentiable
+ * gathers, and results are expanded again using differentiable scatters so
+ * that derivatives only flow through the active entries. Return values that
+ * are unchanged arguments are piped through directly.
+ *
+ * Returns ``false`` without invoking the callback when compaction isn't
+ * worthwhile, in which case the caller should fall back to masking.
+ *
+ * The branch cannot read full-size variables that aren't arguments, since
+ * they are incompatible with the compacted arguments. Retrying with masking
+ * when this happens isn't safe, because the branch may already have performed
+ * side effects. The restriction is documented in set_cond_compact_threshold().
+ */
+static bool ad_cond_compact(JitBackend backend, const char *label,
+                            void *payload, bool value, uint32_t cond,
+                            const dr::vector<uint64_t> &args,
+                            index64_vector &rv, ad_cond_body body_cb) {
+    size_t size = jit_var_size(cond),
+           threshold = ad_cond_compact_threshold();
+
+    if (threshold == 0 || size < threshold || size == 1)
+        return false;
+
+    JitVar lanes = JitVar::steal(jit_var_compress(cond));
+    size_t count = lanes.size();
+
+    // Masking is cheaper when the branch covers most entries. Empty branches
+    // also use masking, since the callback must still produce its outputs.
+    if (count == 0 || count * 2 > size)
+        return false;
+
+    jit_log(LogLevel::InfoSym,
+            "ad_cond_evaluated(\"%s\"): compacting the '%s' branch to %zu/%zu "
+            "entries.", label, value ? "true" : "false", count, size);
+
+    JitVar true_mask = JitVar::steal(jit_var_bool(backend, true)),
+           branch_mask = JitVar::steal(jit_var_mask_default(backend, (uint32_t) count));
+
+    index64_vector args_c;
+    args_c.reserve(args.size());
+    for (uint64_t index : args) {
+        if (jit_var_size((uint32_t) index) == size)
+            args_c.push_back_steal(ad_var_gather(index, lanes.index(),
+                                                 true_mask.index(),
+                                                 ReduceMode::Permute));
+        else
+            args_c.push_back_borrow(index);
+    }
+
+    index64_vector rv_c;
+    {
+        scoped_push_mask guard(backend, branch_mask.index());
+        body_cb(payload, value, args_c, rv_c);
+    }
+
+    rv.reserve(rv_c.size());
+    for (uint64_t index : rv_c) {
+        size_t arg_id = 0;
+        while (arg_id < args_c.size() && args_c[arg_id] != index)
+            arg_id++;
+
+        if (arg_id < args_c.size()) {
+            rv.push_back_borrow(args[arg_id]);
+        } else if (jit_var_size((uint32_t) index) != count) {
+            rv.push_back_borrow(index);
+        } else {
+            JitVar target = JitVar::steal(jit_var_undefined(
+                backend, jit_var_type((uint32_t) index), size));
+
+            rv.push_back_steal(ad_var_scatter(
+                target.index(), index, lanes.index(), true_mask.index(),
+                ReduceOp::Identity, ReduceMode::Permute));
+        }
+    }
+
+    return true;
+}
+
 static void ad_cond_evaluated(JitBackend backend, const char *label,
                               void *payload, uint32_t cond_t, uint32_t cond_f,
                               const dr::vector<uint64_t> &args,
@@ -42,6 +134,10 @@ static void ad_cond_evaluated(JitBackend backend, const char *label,
         size_t size = jit_var_size((uint32_t) index);
         bool is_diff = index != index_lo;
 
+        // Compacted branches may return their argument unchanged
+        if (is_diff)
+            arg_map[(uint32_t) (index >> 32)] = index;
+
         if (is_diff && (size == cond_size || size == 1 || cond_size == 1)) {
             uint64_t idx_t = ad_var_select(cond_t, index, index_lo),
                      idx_f = ad_var_select(cond_f, index, index_lo);
@@ -65,7 +161,8 @@ static void ad_cond_evaluated(JitBackend backend, const char *label,
     rv_t.reserve(args.size());
 
     // Execute 'true_fn'
-    {
+    if (!ad_cond_compact(backend, label, payload, true, cond_t, args, rv_t,
+                         body_cb)) {
         scoped_push_mask guard(backend, cond_t);
         body_cb(payload, true, args_t, rv_t);
     }
@@ -74,7 +171,8 @@ static void ad_cond_evaluated(JitBackend backend, const char *label,
     rv.reserve(rv_t.size());
 
     // Execute 'false_fn'
-    {
+    if (!ad_cond_compact(backend, label, payload, false, cond_f, args, rv_f,
+                         body_cb)) {
         scoped_push_mask guard(backend, cond_f);
         body_cb(payload, false, args_f, rv_f);
     }
@@ -15,18 +15,111 @@
 #include "common.h"
 #include <drjit/custom.h>
 #include <string>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace dr = drjit;
 
 using JitVar = GenericArray<void>;
 
+/// Occupancy below which evaluated loops compress their state
+static std::atomic<float> loop_compress_threshold { 1.f };
+
+/// Number of loop iterations per kernel of hybrid loops (0: adaptive)
+static std::atomic<uint32_t> loop_hybrid_chunk_size { 0 };
+
+/// Number of checkpoints stored by the reverse-mode derivative of symbolic loops (0: unlimited)
+static std::atomic<uint32_t> loop_checkpoint_budget { 0 };
+
+/// Per-loop statistics of evaluated loops with state compression
+static std::unordered_map<std::string, LoopStats> loop_stats;
+static std::mutex loop_stats_mutex;
+
+void ad_loop_set_compress_threshold(float value) {
+    if (!(value > 0.f && value <= 1.f))
+        jit_raise("ad_loop_set_compress_threshold(): the threshold must be "
+                  "in the interval (0, 1].");
+    loop_compress_threshold.store(value, std::memory_order_relaxed);
+}
+
+float ad_loop_compress_threshold() {
+    return loop_compress_threshold.load(std::memory_order_relaxed);
+}
+
+void ad_loop_set_hybrid_chunk_size(uint32_t value) {
+    loop_hybrid_chunk_size.store(value, std::memory_order_relaxed);
+}
+
+uint32_t ad_loop_hybrid_chunk_size() {
+    return loop_hybrid_chunk_size.load(std::memory_order_relaxed);
+}
+
+void ad_loop_set_checkpoint_budget(uint32_t value) {
+    loop_checkpoint_budget.store(value, std::memory_order_relaxed);
+}
+
+uint32_t ad_loop_checkpoint_budget() {
+    return loop_checkpoint_budget.load(std::memory_order_relaxed);
+}
+
+/**
+ * Binomial checkpointing (Revolve): given ``len`` loop iterations that must be
+ * reversed with the help of ``count`` checkpoints, determine the number of
+ * iterations to advance before storing the next checkpoint.
+ *
+ * With ``c`` checkpoints and at most ``r`` recomputations per iteration, one
+ * can reverse up to ``binom(c + r, c)`` iterations. The function finds the
+ * smallest suitable ``r`` and places the checkpoint so that the iterations
+ * before it can be reversed with ``r - 1`` recomputations.
+ */
+static size_t ad_loop_checkpoint_step(size_t len, size_t count) {
+    double prev = 1.0, cur = 1.0;
+    for (size_t r = 1; cur < (double) len; ++r) {
+        prev = cur;
+        cur = cur * (double) (count + r) / (double) r;
+    }
+
+    size_t step = (size_t) prev;
+    if (step > len - 1)
+        step = len - 1;
+    return step ? step : 1;
+}
+
+bool ad_loop_stats(const char *name, LoopStats *out) {
+    std::lock_guard<std::mutex> guard(loop_stats_mutex);
+    auto it = loop_stats.find(name);
+    if (it == loop_stats.end())
+        return false;
+    *out = it->second;
+    return true;
+}
+
+void ad_loop_clear_stats() {
+    std::lock_guard<std::mutex> guard(loop_stats_mutex);
+    loop_stats.clear();
+}
+
+/// Count the active entries of a mask (this launches a reduction)
+static uint32_t ad_loop_count(JitBackend backend, const JitVar &active) {
+    JitVar one = JitVar::steal(jit_var_u32(backend, 1)),
+           zero = JitVar::steal(jit_var_u32(backend, 0)),
+           count = dr::sum(dr::select(active, one, zero));
+
+    uint32_t result = 0;
+    jit_var_read(count.index(), 0, &result);
+    return result;
+}
+
 static bool ad_loop_symbolic(JitBackend backend, const char *name,
                              void *payload,
                              ad_loop_read read_cb, ad_loop_write write_cb,
                              ad_loop_cond cond_cb, ad_loop_body body_cb,
                              index64_vector &backup,
                              dr::vector<uint32_t> &implicit_in,
-                             dr::vector<uint32_t> &implicit_out) {
+                             dr::vector<uint32_t> &implicit_out,
+                             bool *side_effects = nullptr) {
     index64_vector indices1;
     dr::vector<uint32_t> indices2;
 
@@ -58,6 +151,9 @@ static bool ad_loop_symbolic(JitBackend backend, const char *name,
         indices2.clear();
 
         do {
+            // Used to detect side effects of the loop condition and body
+            uint32_t side_effects_before = jit_record_checkpoint(backend);
+
             // Evaluate the loop condition
             uint32_t active_initial = cond_cb(payload);
 
@@ -93,6 +189,10 @@ static bool ad_loop_symbolic(JitBackend backend, const char *name,
                 needs_ad |= (i >> 32) != 0;
             }
 
+            if (side_effects)
+                *side_effects =
+                    jit_record_checkpoint(backend) != side_effects_before;
+
             int rv = jit_var_loop_end(loop.index(), loop_cond.index(),
                                       indices2.data(), record_guard.checkpoint);
 
@@ -198,8 +298,17 @@ static size_t ad_loop_evaluated_mask(JitBackend backend, const char *name,
     return it;
 }
 
-// Simple wavefront-style evaluated loop that progressively reduces the size
-// of the loop state to ignore inactive entries
+/**
+ * Simple wavefront-style evaluated loop that progressively reduces the size of
+ * the loop state to ignore inactive entries.
+ *
+ * Compression gathers or scatters the entire loop state, which is wasteful
+ * when only few entries finished. When the compression threshold (see
+ * ``ad_loop_set_compress_threshold()``) is below 1, the loop therefore first
+ * counts the active entries and only compresses once the fraction of active
+ * entries falls to or below the threshold. Until then, it masks inactive
+ * entries like ``ad_loop_evaluated_mask()``.
+ */
 static size_t
 ad_loop_evaluated_compress(JitBackend backend, const char *name, void *payload,
                            ad_loop_read read_cb, ad_loop_write write_cb,
@@ -264,13 +373,44 @@ ad_loop_evaluated_compress(JitBackend backend, const char *name, void *payload,
      */
     bool reduce_then_gather = backend == JitBackend::LLVM;
 
+    float threshold = ad_loop_compress_threshold();
+    bool adaptive = threshold < 1.f;
+    LoopStats stats { };
+
+    // Mask of the current iteration when the loop state was not compressed
+    JitVar active_masked;
+    index64_vector indices_prev;
+
     while (true) {
         // Determine which entries aren't active, these must be written out
         JitVar not_active = JitVar::steal(jit_var_not(active.index()));
 
         uint32_t size_next = 0;
+        bool compress = true;
 
-        if (reduce_then_gather) {
+        if (adaptive) {
+            for (uint64_t &index: indices) {
+                int unused = 0;
+                uint64_t index_new = ad_var_schedule_force(index, &unused);
+                ad_var_dec_ref(index);
+                index = index_new;
+            }
+            active.schedule_force_();
+            jit_eval();
+
+            uint32_t count = ad_loop_count(backend, active);
+            compress = count == 0 || (float) count <= threshold * (float) size;
+
+            if (!compress) {
+                size_next = size;
+                stats.active_lanes += count;
+                active_masked = active;
+            }
+        }
+
+        if (!compress) {
+            // Postpone compression, inactive entries are masked below
+        } else if (reduce_then_gather) {
             for (uint64_t &index: indices) {
                 int unused = 0;
                 uint64_t index_new = ad_var_schedule_force(index, &unused);
@@ -372,34 +512,222 @@ ad_loop_evaluated_compress(JitBackend backend, const char *name, void *payload,
         if (size_next == 0)
             break; // all done!
 
-        if (size != size_next)
-            jit_log(LogLevel::InfoSym,
-                    "ad_loop_evaluated(\"%s\"): compressed loop state from %u "
-                    "to %u entries.", name, size, size_next);
+        if (compress) {
+            active_masked = JitVar();
+            stats.active_lanes += size_next;
+
+            if (size != size_next) {
+                stats.compressions++;
+                jit_log(LogLevel::InfoSym,
+                        "ad_loop_evaluated(\"%s\"): compressed loop state from %u "
+                        "to %u entries.", name, size, size_next);
+            }
+        } else {
+            stats.masked++;
+        }
 
         size = size_next;
+        stats.iterations++;
+        stats.lanes += size;
         write_cb(payload, indices, false);
-        indices.release();
+
+        if (compress)
+            indices.release();
+        else
+            indices_prev.swap(indices);
 
         jit_log(LogLevel::InfoSym,
                 "ad_loop_evaluated(\"%s\"): executing loop iteration %zu.", name, ++it);
 
         // Execute the loop body
         {
-            scoped_push_mask guard(backend, (uint32_t) true_mask.index());
+            scoped_push_mask guard(backend, compress
+                                                ? (uint32_t) true_mask.index()
+                                                : (uint32_t) active_masked.index());
             body_cb(payload);
         }
 
         active = JitVar::borrow(cond_cb(payload));
         read_cb(payload, indices);
+
+        if (!compress) {
+            // Retain the state of inactive entries
+            for (size_t i = 0; i < indices.size(); ++i) {
+                uint64_t i1 = indices_prev[i], i2 = indices[i];
+
+                // Skip variables that are unchanged or the target of side effects
+                if (skip[i] || i1 == i2 || jit_var_is_dirty((uint32_t) i2))
+                    continue;
+
+                indices[i] = ad_var_select(active_masked.index(), i2, i1);
+                ad_var_dec_ref(i2);
+            }
+
+            indices_prev.release();
+            active &= active_masked;
+        }
     }
 
     if (it > 0)
         write_cb(payload, out_indices, false);
 
+    if (adaptive)
+        jit_log(LogLevel::InfoSym,
+                "ad_loop_evaluated(\"%s\"): %llu iterations, %llu compressions, "
+                "%llu masked iterations, %.1f%% occupancy.", name,
+                (unsigned long long) stats.iterations,
+                (unsigned long long) stats.compressions,
+                (unsigned long long) stats.masked,
+                stats.lanes ? 100.0 * stats.active_lanes / stats.lanes : 100.0);
+
+    {
+        std::lock_guard<std::mutex> guard(loop_stats_mutex);
+        LoopStats &s = loop_stats[name];
+        s.iterations += stats.iterations;
+        s.compressions += stats.compressions;
+        s.masked += stats.masked;
+        s.lanes += stats.lanes;
+        s.active_lanes += stats.active_lanes;
+    }
+
     return it;
 }
 
+/**
+ * Hybrid loops execute like an evaluated loop, whose loop body is itself a
+ * symbolic loop that performs up to ``chunk`` iterations of the original loop.
+ * Every kernel therefore advances the loop state by several iterations, and
+ * the surrounding evaluated loop compresses the state between kernels.
+ *
+ * ``HybridLoop`` wraps the callbacks of the original loop. The same set of
+ * callbacks serves the outer (evaluated) and inner (symbolic) loop. The inner
+ * loop has an extra iteration counter in its loop state.
+ */
+struct HybridLoop {
+    JitBackend backend;
+    const char *name;
+    void *payload;
+    ad_loop_read read_cb;
+    ad_loop_write write_cb;
+    ad_loop_cond cond_cb;
+    ad_loop_body body_cb;
+
+    /// Current number of iterations per kernel
+    uint32_t chunk;
+    /// Adapt 'chunk' to the fraction of entries that remain active?
+    bool adaptive;
+    /// Size of the loop state at the beginning of the previous chunk
+    size_t size_prev = 0;
+    /// Are the callbacks currently invoked by the inner symbolic loop?
+    bool inner = false;
+
+    /// Iteration counter of the inner loop, and its loop condition
+    JitVar counter, cond;
+};
+
+static constexpr uint32_t HybridChunkInit = 8;
+static constexpr uint32_t HybridChunkMax = 256;
+
+static void ad_loop_hybrid_read(void *p, dr::vector<uint64_t> &indices) {
+    HybridLoop *h = (HybridLoop *) p;
+    h->read_cb(h->payload, indices);
+    if (h->inner)
+        indices.push_back(ad_var_inc_ref(h->counter.index()));
+}
+
+static void ad_loop_hybrid_write(void *p, const dr::vector<uint64_t> &indices,
+                                 bool restart) {
+    HybridLoop *h = (HybridLoop *) p;
+    if (!h->inner) {
+        h->write_cb(h->payload, indices, restart);
+        return;
+    }
+
+    size_t n = indices.size() - 1;
+    dr::vector<uint64_t> tmp;
+    tmp.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        tmp.push_back(indices[i]);
+
+    h->write_cb(h->payload, tmp, restart);
+    h->counter = JitVar::borrow((uint32_t) indices[n]);
+}
+
+static uint32_t ad_loop_hybrid_cond(void *p) {
+    HybridLoop *h = (HybridLoop *) p;
+    uint32_t cond = h->cond_cb(h->payload);
+    if (!h->inner)
+        return cond;
+
+    JitVar limit = JitVar::steal(jit_var_u32(h->backend, h->chunk)),
+           in_chunk = JitVar::steal(jit_var_lt(h->counter.index(), limit.index()));
+
+    h->cond = JitVar::steal(jit_var_and(cond, in_chunk.index()));
+    return (uint32_t) h->cond.index();
+}
+
+static void ad_loop_hybrid_body(void *p) {
+    HybridLoop *h = (HybridLoop *) p;
+
+    if (h->inner) {
+        h->body_cb(h->payload);
+        JitVar one = JitVar::steal(jit_var_u32(h->backend, 1));
+        h->counter = JitVar::steal(jit_var_add(h->counter.index(), one.index()));
+        return;
+    }
+
+    // Determine the current size of the loop state
+    size_t size = 0;
+    {
+        index64_vector indices;
+        h->read_cb(h->payload, indices);
+        for (uint64_t index : indices)
+            size = std::max(size, jit_var_size((uint32_t) index));
+    }
+
+    /* Adaptive policy: increase the chunk size while most entries remain
+       active (the kernels are well-occupied), and reduce it once many
+       entries finish within a chunk (the kernels diverge). */
+    if (h->adaptive && h->size_prev) {
+        double ratio = (double) size / (double) h->size_prev;
+        if (ratio >= .9)
+            h->chunk = std::min(h->chunk * 2, HybridChunkMax);
+        else if (ratio < .5)
+            h->chunk = std::max(h->chunk / 2, 1u);
+    }
+    h->size_prev = size;
+
+    jit_log(LogLevel::InfoSym,
+            "ad_loop_hybrid(\"%s\"): running up to %u iterations on %zu "
+            "entries.", h->name, h->chunk, size);
+
+    h->inner = true;
+    h->counter = JitVar::steal(jit_var_u32(h->backend, 0));
+
+    try {
+        index64_vector backup;
+        dr::vector<uint32_t> implicit_in, implicit_out;
+        ad_loop_hybrid_read(h, backup);
+
+        bool needs_ad = ad_loop_symbolic(
+            h->backend, h->name, h, ad_loop_hybrid_read, ad_loop_hybrid_write,
+            ad_loop_hybrid_cond, ad_loop_hybrid_body, backup, implicit_in,
+            implicit_out);
+
+        if (needs_ad)
+            jit_raise("ad_loop_hybrid(\"%s\"): hybrid loops do not support "
+                      "derivative tracking. Please use a symbolic or evaluated "
+                      "loop instead.", h->name);
+    } catch (...) {
+        h->inner = false;
+        h->counter = h->cond = JitVar();
+        throw;
+    }
+
+    h->inner = false;
+    h->counter = h->cond = JitVar();
+}
+
 static void ad_loop_evaluated(JitBackend backend, const char *name,
                               void *payload, ad_loop_read read_cb,
                               ad_loop_write write_cb,
@@ -459,11 +787,12 @@ public:
            ad_loop_body body_cb, ad_loop_delete delete_cb,
            const index64_vector &state,
            const dr::vector<uint32_t> &implicit_in,
-           long long max_iterations)
+           long long max_iterations, bool side_effects)
         : m_backend(backend), m_name(name), m_payload(payload),
           m_read_cb(read_cb), m_write_cb(write_cb), m_cond_cb(cond_cb),
           m_body_cb(body_cb), m_delete_cb(delete_cb), m_diff_count(0),
-          m_max_iterations(max_iterations), m_reset(false) {
+          m_max_iterations(max_iterations), m_side_effects(side_effects),
+          m_reset(false) {
         m_name_op = "Loop: " + m_name;
 
         m_inputs.reserve(state.size());
@@ -643,7 +972,7 @@ public:
         }
 
         ad_loop(
-            m_backend, 1, 0, 0, fwd_name.c_str(), this,
+            m_backend, 1, 0, 0, 0, fwd_name.c_str(), this,
             [](void *p, dr::vector<uint64_t> &i) { ((LoopOp *) p)->read(i); },
             [](void *p, const dr::vector<uint64_t> &i, bool reset) { ((LoopOp *) p)->write(i, reset); },
             [](void *p) { return ((LoopOp *) p)->fwd_cond(); },
@@ -666,10 +995,20 @@ public:
     void backward() override {
         if (m_max_iterations == -1) {
             backward_simple();
+        } else if (m_max_iterations > 0) {
+            if (m_side_effects)
+                jit_raise(
+                    "CustomOp::backward(): the reverse-mode derivative of loop "
+                    "\"%s\" replays the loop body, but the body performs side "
+                    "effects (e.g., scatter operations) that would then run a "
+                    "second time. Please move them out of the loop or "
+                    "differentiate the loop in forward mode.", m_name.c_str());
+            backward_checkpointed();
         } else {
-            jit_raise("CustomOp::backward(): the reverse-mode derivative of a "
-                      "complex loop (with max_iterations != -1) is not yet "
-                      "implemented!");
+            jit_raise("CustomOp::backward(): the reverse-mode derivative of "
+                      "this loop requires an upper bound on the number of "
+                      "loop iterations. Please specify the 'max_iterations' "
+                      "parameter of drjit.while_loop().");
         }
     }
 
@@ -766,6 +1105,274 @@ public:
         m_state2.release();
     }
 
+    /* The backward_checkpointed() function below implements general
+       reverse-mode differentiation by replaying the loop in evaluated form:
+
+         grad_state = <gradients of the loop outputs>
+
+         for it in reversed(range(iterations)):
+             state = <loop state at the beginning of iteration 'it'>
+             dr.enable_grad(state)
+             state_next = dr.select(cond(state), body(state), state)
+             grad_state = dr.backward_to(state, grad=grad_state)
+
+         grad_state_in += grad_state
+
+       Storing the state of every iteration would require memory that grows
+       linearly with the iteration count. The function instead stores a limited
+       number of checkpoints (see ad_loop_set_checkpoint_budget()) following a
+       binomial schedule and recomputes intermediate states from them. The
+       first checkpoints are already recorded while counting the iterations.
+       This only concerns symbolic loops. Evaluated loops record their AD graph
+       while running, and their memory use remains linear in the iteration
+       count.
+
+       The replay would repeat side effects of the loop body (e.g., scatters to
+       captured arrays). backward() therefore refuses to differentiate such
+       loops in this way. Side effects are detected while recording the loop
+       (see ad_loop_symbolic()).
+     */
+
+    /// Set the (non-differentiable) loop state and evaluate the loop condition
+    JitVar ckpt_cond(const index64_vector &state) {
+        m_write_cb(m_payload, state, true);
+        uint32_t active = m_cond_cb(m_payload);
+        return JitVar::steal(
+            jit_var_mask_apply(active, (uint32_t) jit_var_size(active)));
+    }
+
+    /// Run the loop body following ckpt_cond() and evaluate the new state
+    void ckpt_body(index64_vector &state, const JitVar &active) {
+        {
+            scoped_push_mask guard(m_backend, (uint32_t) active.index());
+            m_body_cb(m_payload);
+        }
+
+        index64_vector state2;
+        m_read_cb(m_payload, state2);
+
+        for (size_t i = 0; i < state2.size(); ++i) {
+            uint64_t i1 = state[i], i2 = state2[i];
+
+            // Mask disabled lanes, skip unchanged variables and side effects
+            if (i1 != i2 && !jit_var_is_dirty((uint32_t) i2)) {
+                state2[i] = ad_var_select(active.index(), i2, i1);
+                ad_var_dec_ref(i2);
+            }
+
+            // Strip AD variables (e.g., of differentiable captured variables)
+            int unused = 0;
+            uint64_t index = state2[i];
+            state2[i] = jit_var_schedule_force((uint32_t) index, &unused);
+            ad_var_dec_ref(index);
+        }
+
+        jit_eval();
+        state.release();
+        state.swap(state2);
+    }
+
+    /// Advance a loop state by the given number of iterations
+    void ckpt_advance(index64_vector &state, size_t count) {
+        scoped_suspend_grad guard;
+        for (size_t i = 0; i < count; ++i) {
+            JitVar active = ckpt_cond(state);
+            ckpt_body(state, active);
+        }
+    }
+
+    /// Propagate gradients through the loop iteration starting at 'state'
+    void ckpt_reverse(const index64_vector &state, index32_vector &grad) {
+        index64_vector state_ad, state_out;
+        for (size_t i = 0; i < m_inputs.size(); ++i) {
+            if (m_inputs[i].is_diff)
+                state_ad.push_back_steal(ad_var_new((uint32_t) state[i]));
+            else
+                state_ad.push_back_borrow(state[i]);
+        }
+
+        m_write_cb(m_payload, state_ad, true);
+        uint32_t active_i = m_cond_cb(m_payload);
+        JitVar active = JitVar::steal(
+            jit_var_mask_apply(active_i, (uint32_t) jit_var_size(active_i)));
+
+        {
+            scoped_push_mask guard(m_backend, (uint32_t) active.index());
+            m_body_cb(m_payload);
+        }
+        m_read_cb(m_payload, state_out);
+
+        // AD backward propagation pass
+        size_t offset = 0;
+        for (size_t i = 0; i < m_inputs.size(); ++i) {
+            if (!m_inputs[i].is_diff)
+                continue;
+
+            uint64_t i1 = state_ad[i], i2 = state_out[i];
+            if (i1 != i2 && !jit_var_is_dirty((uint32_t) i2)) {
+                state_out[i] = ad_var_select(active.index(), i2, i1);
+                ad_var_dec_ref(i2);
+            }
+
+            ad_accum_grad(state_out[i], grad[offset++]);
+            ad_enqueue(dr::ADMode::Backward, state_out[i]);
+        }
+
+        ad_traverse(dr::ADMode::Backward, (uint32_t) dr::ADFlag::ClearNone);
+
+        // Fetch the gradients of the loop state at the beginning of the iteration
+        offset = 0;
+        for (size_t i = 0; i < m_inputs.size(); ++i) {
+            if (!m_inputs[i].is_diff)
+                continue;
+
+            int unused = 0;
+            JitVar grad_i = JitVar::steal(ad_grad(state_ad[i]));
+            jit_var_dec_ref(grad[offset]);
+            grad[offset++] = jit_var_schedule_force(grad_i.index(), &unused);
+        }
+
+        jit_eval();
+    }
+
+    void backward_checkpointed() {
+        struct Checkpoint {
+            size_t it;
+            index64_vector state;
+        };
+
+        auto copy_state = [](const index64_vector &state) {
+            index64_vector result;
+            for (uint64_t index : state)
+                result.push_back_borrow(index);
+            return result;
+        };
+
+        std::vector<Checkpoint> checkpoints;
+        {
+            index64_vector state;
+            for (const Input &in : m_inputs)
+                state.push_back_borrow(in.index);
+            checkpoints.push_back({ 0, std::move(state) });
+        }
+
+        // Gradients of the differentiable loop state variables
+        index32_vector grad;
+        for (const Input &in : m_inputs) {
+            if (!in.is_diff)
+                continue;
+
+            uint64_t zero = 0;
+            if (in.has_grad_out)
+                grad.push_back_steal(
+                    ad_grad(combine(m_output_indices[in.grad_out_offset])));
+            else
+                grad.push_back_steal(
+                    jit_var_literal(m_backend, jit_var_type(in.index), &zero));
+        }
+
+        /* Determine the number of loop iterations and record checkpoints
+           along the way. Without a budget, this stores the state of every
+           iteration. Otherwise, it keeps at most half of the budget using a
+           stride that doubles whenever the checkpoints run out, and leaves
+           the remainder to the binomial schedule below. */
+        size_t budget = ad_loop_checkpoint_budget(), iterations = 0,
+               keep = budget ? std::max(budget / 2, (size_t) 1) : 0,
+               stride = 1;
+        {
+            scoped_suspend_grad guard;
+            index64_vector state = copy_state(checkpoints[0].state);
+            while (true) {
+                JitVar active = ckpt_cond(state);
+                active.schedule_force_();
+                jit_eval();
+
+                if (!jit_var_any(active.index()))
+                    break;
+
+                if ((long long) iterations >= m_max_iterations)
+                    jit_raise("CustomOp::backward(): loop \"%s\" ran for more "
+                              "than %lld iterations, which exceeds the "
+                              "specified bound (max_iterations=%lld).",
+                              m_name.c_str(), m_max_iterations,
+                              m_max_iterations);
+
+                if (iterations > 0 && iterations % stride == 0) {
+                    if (keep && checkpoints.size() - 1 == keep) {
+                        // Thin out the checkpoints and double the stride
+                        size_t j = 1;
+                        for (size_t i = 1; i < checkpoints.size(); ++i) {
+                            if (checkpoints[i].it % (2 * stride) != 0)
+                                continue;
+                            if (i != j)
+                                checkpoints[j] = std::move(checkpoints[i]);
+                            j++;
+                        }
+                        checkpoints.resize(j);
+                        stride *= 2;
+                    }
+
+                    if (iterations % stride == 0)
+                        checkpoints.push_back({ iterations, copy_state(state) });
+                }
+
+                ckpt_body(state, active);
+                iterations++;
+            }
+        }
+
+        // Reverse the iterations, from last to first
+        size_t end = iterations, recomputed = 0,
+               stored = checkpoints.size() - 1;
+
+        while (end > 0) {
+            size_t it = checkpoints.back().it, len = end - it;
+
+            if (len == 1) {
+                ckpt_reverse(checkpoints.back().state, grad);
+                end--;
+                if (checkpoints.size() > 1)
+                    checkpoints.pop_back();
+                continue;
+            }
+
+            size_t available = budget ? budget - (checkpoints.size() - 1) : len;
+            index64_vector state = copy_state(checkpoints.back().state);
+
+            if (available == 0) {
+                // Out of memory, recompute from the last checkpoint
+                ckpt_advance(state, len - 1);
+                ckpt_reverse(state, grad);
+                recomputed += len - 1;
+                end--;
+                continue;
+            }
+
+            size_t step = ad_loop_checkpoint_step(len, available);
+            ckpt_advance(state, step);
+            recomputed += step;
+            checkpoints.push_back({ it + step, std::move(state) });
+            if (checkpoints.size() - 1 > stored)
+                stored = checkpoints.size() - 1;
+        }
+
+        jit_log(LogLevel::InfoSym,
+                "CustomOp::backward(\"%s\"): reversed %zu loop iterations "
+                "(recomputed %zu iterations, stored up to %zu checkpoints).",
+                m_name.c_str(), iterations, recomputed, stored);
+
+        size_t offset = 0, ctr = 0;
+        for (const Input &in : m_inputs) {
+            if (!in.is_diff)
+                continue;
+            if (in.has_grad_in)
+                ad_accum_grad(combine(m_input_indices[ctr++]), grad[offset]);
+            offset++;
+        }
+    }
+
+    // -------------------------------------------------------------------
+
     void backward_simple() {
         std::string fwd_name = m_name + " [ad, bwd, simple]";
 
@@ -789,7 +1396,7 @@ public:
         }
 
         ad_loop(
-            m_backend, 1, 0, 0, fwd_name.c_str(), this,
+            m_backend, 1, 0, 0, 0, fwd_name.c_str(), this,
             [](void *p, dr::vector<uint64_t> &i) { ((LoopOp *) p)->read(i); },
             [](void *p, const dr::vector<uint64_t> &i, bool reset) { ((LoopOp *) p)->write(i, reset); },
             [](void *p) { return ((LoopOp *) p)->fwd_cond(); },
@@ -860,13 +1467,146 @@ private:
     // Offset of implicit indices in m_input_indices
     size_t m_implicit_in_offset;
     long long m_max_iterations;
+    bool m_side_effects;
     bool m_reset;
 };
 
-bool ad_loop(JitBackend backend, int symbolic, int compress,
-             long long max_iterations, const char *name, void *payload,
-             ad_loop_read read_cb, ad_loop_write write_cb, ad_loop_cond cond_cb,
-             ad_loop_body body_cb, ad_loop_delete delete_cb, bool ad) {
+/**
+ * Partially unrolled loops wrap the callbacks of the original loop so that
+ * every invocation of the loop body performs ``factor`` iterations. The first
+ * iteration runs under the mask of the surrounding loop, and each of the
+ * remaining ones re-evaluates the loop condition, masks side effects, and
+ * blends the new loop state with the previous one.
+ */
+struct UnrolledLoop {
+    JitBackend backend;
+    void *payload;
+    ad_loop_read read_cb;
+    ad_loop_write write_cb;
+    ad_loop_cond cond_cb;
+    ad_loop_body body_cb;
+    ad_loop_delete delete_cb;
+
+    /// Number of iterations per invocation of the loop body
+    uint32_t factor;
+};
+
+static void ad_loop_unroll_read(void *p, dr::vector<uint64_t> &indices) {
+    UnrolledLoop *u = (UnrolledLoop *) p;
+    u->read_cb(u->payload, indices);
+}
+
+static void ad_loop_unroll_write(void *p, const dr::vector<uint64_t> &indices,
+                                 bool restart) {
+    UnrolledLoop *u = (UnrolledLoop *) p;
+    u->write_cb(u->payload, indices, restart);
+}
+
+static uint32_t ad_loop_unroll_cond(void *p) {
+    UnrolledLoop *u = (UnrolledLoop *) p;
+    return u->cond_cb(u->payload);
+}
+
+static void ad_loop_unroll_body(void *p) {
+    UnrolledLoop *u = (UnrolledLoop *) p;
+    u->body_cb(u->payload);
+
+    JitVar active;
+    index64_vector indices1, indices2;
+
+    for (uint32_t i = 1; i < u->factor; ++i) {
+        uint32_t active_i = u->cond_cb(u->payload);
+
+        // Restrict to the current mask and to entries that remained active
+        JitVar active_m = JitVar::steal(
+            jit_var_mask_apply(active_i, (uint32_t) jit_var_size(active_i)));
+        if (active.valid())
+            active_m &= active;
+        active = std::move(active_m);
+
+        indices1.release();
+        u->read_cb(u->payload, indices1);
+
+        {
+            scoped_push_mask guard(u->backend, (uint32_t) active.index());
+            u->body_cb(u->payload);
+        }
+
+        u->read_cb(u->payload, indices2);
+
+        // Mask disabled lanes and write back
+        for (size_t j = 0; j < indices1.size(); ++j) {
+            uint64_t i1 = indices1[j], i2 = indices2[j];
+
+            // Skip variables that are unchanged or the target of side effects
+            if (i1 == i2 || jit_var_is_dirty((uint32_t) i2))
+                continue;
+
+            indices2[j] = ad_var_select(active.index(), i2, i1);
+            ad_var_dec_ref(i2);
+        }
+
+        u->write_cb(u->payload, indices2, false);
+        indices2.release();
+    }
+}
+
+static void ad_loop_unroll_delete(void *p) {
+    UnrolledLoop *u = (UnrolledLoop *) p;
+    if (u->delete_cb)
+        u->delete_cb(u->payload);
+    delete u;
+}
+
+/// Fully unroll a loop whose condition is a literal in every iteration
+static void ad_loop_unroll_full(const char *name, long long max_iterations,
+                                void *payload, ad_loop_read read_cb,
+                                ad_loop_write write_cb, ad_loop_cond cond_cb,
+                                ad_loop_body body_cb) {
+    index64_vector indices;
+    size_t it = 0;
+
+    while (true) {
+        uint32_t active = cond_cb(payload);
+
+        if (jit_var_state(active) != VarState::Literal)
+            jit_raise("ad_loop(\"%s\"): full unrolling requires a loop "
+                      "condition that is a literal constant in every "
+                      "iteration, which is not the case in iteration %zu.",
+                      name, it + 1);
+
+        if (jit_var_is_zero_literal(active))
+            break;
+
+        if (max_iterations > 0 && it == (size_t) max_iterations)
+            jit_raise("ad_loop(\"%s\"): the loop did not terminate within the "
+                      "specified number of iterations (%lld).", name,
+                      max_iterations);
+
+        body_cb(payload);
+        it++;
+
+        // Keep the caller's view of the loop state up to date
+        read_cb(payload, indices);
+        write_cb(payload, indices, false);
+        indices.release();
+    }
+
+    jit_log(LogLevel::InfoSym,
+            "ad_loop(\"%s\"): fully unrolled %zu iterations.", name, it);
+}
+
+/**
+ * Implementation of ad_loop(). When a ``LoopOp`` takes ownership of the
+ * payload, this is reported through ``transferred``. From then on, the payload
+ * is released by the ``LoopOp`` even if the function raises an exception.
+ */
+static bool ad_loop_impl(JitBackend backend, int symbolic, int compress,
+                         long long max_iterations, int unroll, const char *name,
+                         void *payload, ad_loop_read read_cb,
+                         ad_loop_write write_cb, ad_loop_cond cond_cb,
+                         ad_loop_body body_cb, ad_loop_delete delete_cb,
+                         bool ad, bool &transferred) {
     if (name == nullptr)
         name = "unnamed";
 
@@ -890,27 +1630,80 @@ bool ad_loop(JitBackend backend, int symbolic, int compress,
     }
 
     if (compress == -1)
-        compress = (int) bool(flags & (uint32_t) JitFlag::CompressLoops);
+        compress = symbolic == 2 ||
+                   bool(flags & (uint32_t) JitFlag::CompressLoops);
 
-    if (symbolic != 0 && symbolic != 1)
-        jit_raise("'symbolic' must equal 0, 1, or -1.");
+    if (symbolic != 0 && symbolic != 1 && symbolic != 2)
+        jit_raise("'symbolic' must equal 0, 1, 2, or -1.");
 
     if (compress != 0 && compress != 1)
         jit_raise("'compress' must equal 0, 1, or -1.");
 
+    if (symbolic == 2) {
+        bool needs_ad = false;
+        {
+            index64_vector indices;
+            read_cb(payload, indices);
+            for (uint64_t i : indices)
+                needs_ad |= (i >> 32) != 0;
+        }
+
+        if (needs_ad && ad) {
+            jit_log(LogLevel::InfoSym,
+                    "ad_loop(\"%s\"): hybrid loops do not support derivative "
+                    "tracking, switching to evaluated mode.", name);
+            symbolic = 0;
+        }
+    }
+
     if (max_iterations < -1)
         jit_raise("'max_iterations' must be >= -1.");
 
-    if (symbolic) {
+    if (unroll < -1)
+        jit_raise("'unroll' must be >= -1.");
+
+    if (unroll == -1) {
+        ad_loop_unroll_full(name, max_iterations, payload, read_cb, write_cb,
+                            cond_cb, body_cb);
+        return true;
+    }
+
+    if (unroll > 1) {
+        UnrolledLoop *u = new UnrolledLoop{ backend, payload, read_cb,
+                                            write_cb, cond_cb, body_cb,
+                                            delete_cb, (uint32_t) unroll };
+        bool rv, u_transferred = false;
+        try {
+            rv = ad_loop_impl(backend, symbolic, compress, max_iterations, 0,
+                              name, u, ad_loop_unroll_read,
+                              ad_loop_unroll_write, ad_loop_unroll_cond,
+                              ad_loop_unroll_body, ad_loop_unroll_delete, ad,
+                              u_transferred);
+        } catch (...) {
+            // A 'LoopOp' that took ownership of 'u' will delete it
+            if (!u_transferred)
+                delete u;
+            throw;
+        }
+
+        // Otherwise, LoopOp will eventually call ad_loop_unroll_delete()
+        if (rv)
+            delete u;
+
+        return rv;
+    }
+
+    if (symbolic == 1) {
         index64_vector indices_in;
         read_cb(payload, indices_in);
         dr::detail::ad_index32_vector implicit_in, implicit_out;
 
-        bool needs_ad;
+        bool needs_ad, side_effects = false;
         {
             needs_ad = ad_loop_symbolic(backend, name, payload, read_cb,
                                         write_cb, cond_cb, body_cb, indices_in,
-                                        implicit_in, implicit_out);
+                                        implicit_in, implicit_out,
+                                        &side_effects);
         }
 
         if (needs_ad && ad) {
@@ -920,7 +1713,8 @@ bool ad_loop(JitBackend backend, int symbolic, int compress,
             nanobind::ref<LoopOp> op =
                 new LoopOp(backend, name, payload, read_cb, write_cb,
                            cond_cb, body_cb, delete_cb, indices_in,
-                           implicit_in, max_iterations);
+                           implicit_in, max_iterations, side_effects);
+            transferred = true;
 
             for (size_t i = 0; i < indices_out.size(); ++i) {
                 VarType vt = jit_var_type((uint32_t) indices_out[i]);
@@ -952,6 +1746,7 @@ bool ad_loop(JitBackend backend, int symbolic, int compress,
 
             // CustomOp was not needed, detach output again..
             op->disable_deleter();
+            transferred = false;
             write_cb(payload, indices_out, false);
         }
     } else {
@@ -967,10 +1762,32 @@ bool ad_loop(JitBackend backend, int symbolic, int compress,
                       "evaluated loops, as well as their limitations.");
 
         scoped_isolation_boundary guard;
-        ad_loop_evaluated(backend, name, payload, read_cb, write_cb,
-                          cond_cb, body_cb, compress);
+        if (symbolic == 2) {
+            uint32_t chunk = ad_loop_hybrid_chunk_size();
+            HybridLoop h { backend, name, payload, read_cb, write_cb,
+                           cond_cb, body_cb, chunk ? chunk : HybridChunkInit,
+                           chunk == 0 };
+
+            ad_loop_evaluated(backend, name, &h, ad_loop_hybrid_read,
+                              ad_loop_hybrid_write, ad_loop_hybrid_cond,
+                              ad_loop_hybrid_body, compress);
+        } else {
+            ad_loop_evaluated(backend, name, payload, read_cb, write_cb,
+                              cond_cb, body_cb, compress);
+        }
         guard.disarm();
     }
 
     return true; // Caller should directly call delete()
 }
+
+bool ad_loop(JitBackend backend, int symbolic, int compress,
+             long long max_iterations, int unroll, const char *name,
+             void *payload, ad_loop_read read_cb, ad_loop_write write_cb,
+             ad_loop_cond cond_cb, ad_loop_body body_cb,
+             ad_loop_delete delete_cb, bool ad) {
+    bool transferred = false;
+    return ad_loop_impl(backend, symbolic, compress, max_iterations, unroll,
+                        name, payload, read_cb, write_cb, cond_cb, body_cb,
+                        delete_cb, ad, transferred);
+}
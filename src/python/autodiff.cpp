@@ -561,6 +561,7 @@ void export_autodiff(nb::module_ &m) {
         .value("ClearInterior", dr::ADFlag::ClearInterior, doc_ADFlag_ClearInterior)
         .value("ClearVertices", dr::ADFlag::ClearVertices, doc_ADFlag_ClearVertices)
         .value("AllowNoGrad", dr::ADFlag::AllowNoGrad, doc_ADFlag_AllowNoGrad)
+        .value("ParallelTraversal", dr::ADFlag::ParallelTraversal, doc_ADFlag_ParallelTraversal)
         .value("Default", dr::ADFlag::Default, doc_ADFlag_Default);
 
     m.def("set_grad_enabled", &set_grad_enabled, doc_set_grad_enabled)
@@ -605,6 +606,13 @@ void export_autodiff(nb::module_ &m) {
      .def("backward_to", &backward_to_2, "args"_a, "kwargs"_a,
           nb::sig("def backward_to(*args: *Ts, flags: drjit.ADFlag | int = drjit.ADFlag.Default) -> tuple[*Ts]"));
 
+    m.def("set_grad_memory_budget", &ad_set_memory_budget, "size"_a,
+          doc_set_grad_memory_budget)
+     .def("grad_memory_budget", &ad_memory_budget, doc_grad_memory_budget)
+     .def("compact_grad_graph", &ad_compact_graph, doc_compact_grad_graph)
+     .def("set_grad_compact_threshold", &ad_set_compact_threshold, "size"_a,
+          doc_set_grad_compact_threshold);
+
     /// Internal context managers for drjit.isolate_grad(), drjit.suspend_grad(), etc.
     nb::module_ detail = nb::module_::import_("drjit.detail");
 
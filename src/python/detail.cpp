@@ -304,6 +304,10 @@ void export_detail(nb::module_ &) {
      .def("trace_func", &trace_func, "frame"_a, "event"_a,
           "arg"_a = nb::none())
 
+     .def("log",
+          [](LogLevel level, const char *msg) { jit_log(level, "%s", msg); },
+          "level"_a, "msg"_a)
+
      .def("clear_registry", &jit_registry_clear, doc_detail_clear_registry)
 
      .def("import_tensor",
@@ -9,6 +9,7 @@
 */
 
 #include "history.h"
+#include <drjit/extra.h>
 
 void export_history(nb::module_ &m) {
     nb::object io = nb::module_::import_("io").attr("StringIO");
@@ -55,11 +56,41 @@ void export_history(nb::module_ &m) {
                 entry++;
             }
             free(data);
+
+            // Vectorized calls that were inlined by ad_call()
+            CallHistoryEntry *calls = ad_call_history(), *call = calls;
+            bool queried_calls = types.size() == 0;
+            for (KernelType t : types)
+                queried_calls |= t == KernelType::Other;
+
+            while (call && (uint32_t) call->backend) {
+                if (queried_calls) {
+                    nb::dict dict;
+                    dict["backend"]        = call->backend;
+                    dict["type"]           = KernelType::Other;
+                    dict["devirtualized"]  = call->name;
+                    dict["instance"]       = call->instance;
+                    dict["size"]           = call->size;
+                    dict["input_count"]    = 0;
+                    dict["output_count"]   = 0;
+                    dict["execution_time"] = 0.f;
+                    history.append(dict);
+                }
+
+                free(call->name);
+                call++;
+            }
+            free(calls);
+
             return history;
         },
         "types"_a = nb::list(), doc_kernel_history);
 
-    m.def("kernel_history_clear", &jit_kernel_history_clear,
+    m.def("kernel_history_clear",
+          []() {
+              jit_kernel_history_clear();
+              ad_call_history_clear();
+          },
           doc_kernel_history_clear);
 
     nb::enum_<KernelType>(m, "KernelType")
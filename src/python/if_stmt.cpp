@@ -27,11 +27,11 @@ struct IfState {
 
     IfState(nb::object &&args, nb::callable &&true_fn, nb::callable &&false_fn,
             dr::vector<dr::string> &&arg_labels,
-            dr::vector<dr::string> &&rv_labels, bool strict)
+            dr::vector<dr::string> &&rv_labels, bool strict, bool check_size)
         : args(std::move(args)), true_fn(std::move(true_fn)),
           false_fn(std::move(false_fn)),
           arg_labels(std::move(arg_labels)), rv_labels(std::move(rv_labels)),
-          tracker(strict) { }
+          tracker(strict, check_size) { }
 };
 
 static void if_stmt_body_cb(void *p, bool cond_val,
@@ -123,10 +123,22 @@ nb::object if_stmt(nb::tuple args, nb::handle cond, nb::callable true_fn,
         const char *name_cstr =
             name.has_value() ? name.value().c_str() : "unnamed";
 
+        // Evaluated conditionals may run branches on a compacted subset of
+        // the entries, which changes the size of the state variables. Resolve
+        // the automatic mode like ad_cond() so that the size checks remain
+        // active whenever the conditional is captured symbolically.
+        bool evaluated = symbolic == 0;
+        if (symbolic == -1) {
+            uint32_t flags = jit_flags();
+            evaluated = !(flags & (uint32_t) JitFlag::SymbolicScope) &&
+                        !(flags & (uint32_t) JitFlag::SymbolicConditionals);
+        }
+        bool check_size = !evaluated || ad_cond_compact_threshold() == 0;
+
         dr::unique_ptr<IfState> is(
             new IfState(std::move(args), std::move(true_fn),
                         std::move(false_fn), std::move(arg_labels),
-                        std::move(rv_labels), strict));
+                        std::move(rv_labels), strict, check_size));
 
         // Temporarily stash the reference counts of inputs. This influences the
         // behavior of copy-on-write (COW) operations like dr.scatter performed
@@ -189,4 +201,9 @@ void export_if_stmt(nb::module_ &m) {
                         "strict: bool = True) "
             "-> T")
     );
+
+    m.def("set_cond_compact_threshold", &ad_cond_set_compact_threshold,
+          "value"_a, doc_set_cond_compact_threshold);
+    m.def("cond_compact_threshold", &ad_cond_compact_threshold,
+          doc_cond_compact_threshold);
 }
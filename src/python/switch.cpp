@@ -299,5 +299,20 @@ void export_switch(nb::module_& m) {
     m.def("switch", &switch_impl, doc_switch, "index"_a,
           "targets"_a, "args"_a, "kwargs"_a)
      .def("dispatch", &dispatch_impl, doc_dispatch, "inst"_a,
-          "target"_a, "args"_a, "kwargs"_a);
+          "target"_a, "args"_a, "kwargs"_a)
+     .def("set_call_sort_by_callee", &ad_call_set_sort_by_callee, "value"_a,
+          doc_set_call_sort_by_callee)
+     .def("call_sort_by_callee", &ad_call_sort_by_callee,
+          doc_call_sort_by_callee)
+     .def("set_call_batched", &ad_call_set_batched, "value"_a,
+          doc_set_call_batched)
+     .def("call_batched", &ad_call_batched, doc_call_batched)
+     .def("set_call_small_bucket_threshold",
+          &ad_call_set_small_bucket_threshold, "value"_a,
+          doc_set_call_small_bucket_threshold)
+     .def("call_small_bucket_threshold", &ad_call_small_bucket_threshold,
+          doc_call_small_bucket_threshold)
+     .def("set_call_devirtualize", &ad_call_set_devirtualize, "value"_a,
+          doc_set_call_devirtualize)
+     .def("call_devirtualize", &ad_call_devirtualize, doc_call_devirtualize);
 }
@@ -115,7 +115,8 @@ nb::tuple while_loop(nb::tuple state, nb::callable cond, nb::callable body,
                      std::optional<dr::string> mode,
                      bool strict,
                      std::optional<bool> compress,
-                     std::optional<long long> max_iterations) {
+                     std::optional<long long> max_iterations,
+                     nb::handle unroll) {
     try {
         JitBackend backend = JitBackend::None;
 
@@ -159,9 +160,23 @@ nb::tuple while_loop(nb::tuple state, nb::callable cond, nb::callable body,
             symbolic = 1;
         else if (mode == "evaluated")
             symbolic = 0;
+        else if (mode == "hybrid")
+            symbolic = 2;
         else
             nb::raise("invalid 'mode' argument (must equal None, "
-                      "\"scalar\", \"symbolic\", or \"evaluated\")");
+                      "\"scalar\", \"symbolic\", \"evaluated\", or "
+                      "\"hybrid\")");
+
+        int unroll_i = 0;
+        if (unroll.is_none())
+            unroll_i = 0;
+        else if (unroll.equal(nb::str("full")))
+            unroll_i = -1;
+        else if (nb::isinstance<int>(unroll) && nb::cast<int>(unroll) >= 1)
+            unroll_i = nb::cast<int>(unroll);
+        else
+            nb::raise("invalid 'unroll' argument (must equal None, "
+                      "\"full\", or a positive integer)");
 
         const char *name_cstr =
             name.has_value() ? name.value().c_str() : "unnamed";
@@ -174,7 +189,7 @@ nb::tuple while_loop(nb::tuple state, nb::callable cond, nb::callable body,
         bool rv = ad_loop(backend, symbolic,
                           compress.has_value() ? (int) compress.value() : -1,
                           max_iterations.has_value() ? max_iterations.value() : 0,
-                          name_cstr, ls.get(), while_loop_read_cb,
+                          unroll_i, name_cstr, ls.get(), while_loop_read_cb,
                           while_loop_write_cb, while_loop_cond_cb,
                           while_loop_body_cb, while_loop_delete_cb, true);
 
@@ -210,7 +225,7 @@ void export_while_loop(nb::module_ &m) {
           "labels"_a = nb::make_tuple(), "label"_a = nb::none(),
           "mode"_a = nb::none(), "strict"_a = true,
           "compress"_a = nb::none(), "max_iterations"_a = nb::none(),
-          doc_while_loop,
+          "unroll"_a = nb::none(), doc_while_loop,
           // Complicated signature to type-check while_loop via TypeVarTuple
           nb::sig(
             "def while_loop(state: tuple[*Ts], "
@@ -218,10 +233,39 @@ void export_while_loop(nb::module_ &m) {
                            "body: typing.Callable[[*Ts], tuple[*Ts]], "
                            "labels: typing.Sequence[str] = (), "
                            "label: str | None = None, "
-                           "mode: typing.Literal['scalar', 'symbolic', 'evaluated', None] = None, "
+                           "mode: typing.Literal['scalar', 'symbolic', 'evaluated', 'hybrid', None] = None, "
                            "strict: bool = True, "
                            "compress: bool | None = None, "
-                           "max_iterations: int | None = None) "
+                           "max_iterations: int | None = None, "
+                           "unroll: int | typing.Literal['full'] | None = None) "
             "-> tuple[*Ts]"
     ));
+
+    m.def("set_loop_compress_threshold", &ad_loop_set_compress_threshold,
+          "value"_a, doc_set_loop_compress_threshold);
+    m.def("loop_compress_threshold", &ad_loop_compress_threshold,
+          doc_loop_compress_threshold);
+    m.def("set_loop_hybrid_chunk_size", &ad_loop_set_hybrid_chunk_size,
+          "value"_a, doc_set_loop_hybrid_chunk_size);
+    m.def("loop_hybrid_chunk_size", &ad_loop_hybrid_chunk_size,
+          doc_loop_hybrid_chunk_size);
+    m.def("set_loop_checkpoint_budget", &ad_loop_set_checkpoint_budget,
+          "value"_a, doc_set_loop_checkpoint_budget);
+    m.def("loop_checkpoint_budget", &ad_loop_checkpoint_budget,
+          doc_loop_checkpoint_budget);
+    m.def("loop_stats",
+          [](const char *name) -> nb::object {
+              LoopStats stats;
+              if (!ad_loop_stats(name, &stats))
+                  return nb::none();
+
+              nb::dict result;
+              result["iterations"] = stats.iterations;
+              result["compressions"] = stats.compressions;
+              result["masked"] = stats.masked;
+              result["lanes"] = stats.lanes;
+              result["active_lanes"] = stats.active_lanes;
+              return result;
+          }, "name"_a, doc_loop_stats);
+    m.def("clear_loop_stats", &ad_loop_clear_stats, doc_clear_loop_stats);
 }
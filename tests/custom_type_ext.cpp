@@ -1,5 +1,6 @@
 #include <drjit/python.h>
 #include <drjit/autodiff.h>
+#include <drjit/custom.h>
 #include <drjit/packet.h>
 
 namespace nb = nanobind;
@@ -44,6 +45,14 @@ template <JitBackend Backend> void bind(nb::module_ &m) {
         .def_prop_rw("b",
             [](Color3f &c) -> Float & { return c.b(); },
             [](Color3f &c, Float &value) { c.b() = value; });
+
+    // Tests: C++ interface of drjit::checkpoint()
+    m.def("checkpoint", [](const Float &x, const Float &y) {
+        return dr::checkpoint(
+            [](const Float &a, const Float &b) {
+                return dr::sin(a) * b + a * a;
+            }, x, y);
+    });
 }
 
 NB_MODULE(custom_type_ext, m) {
@@ -0,0 +1,180 @@
+#include <nanobind/nanobind.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+#include <drjit/packet.h>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace nb = nanobind;
+namespace dr = drjit;
+
+using dr::half;
+
+/// Compare the result of a half precision packet operation against the scalar
+/// 'half' path (evaluate in single precision and round)
+template <size_t N, typename Array, typename Func>
+void check_op(std::vector<std::string> &failed, const char *name,
+              const Array &value, Func func, float tol = 0.f) {
+    for (size_t i = 0; i < N; ++i) {
+        float ref = (float) half(func(i)),
+              val = (float) value.entry(i);
+
+        bool ok = (std::isnan(ref) && std::isnan(val)) ||
+                  std::abs(ref - val) <= tol * std::abs(ref);
+
+        if (!ok) {
+            failed.push_back(std::string(name) + "[" + std::to_string(N) +
+                             "][" + std::to_string(i) + "]: expected " +
+                             std::to_string(ref) + ", got " +
+                             std::to_string(val));
+            return;
+        }
+    }
+}
+
+template <size_t N, typename Mask, typename Func>
+void check_mask(std::vector<std::string> &failed, const char *name,
+                const Mask &value, Func func) {
+    for (size_t i = 0; i < N; ++i) {
+        if ((bool) value.entry(i) != func(i)) {
+            failed.push_back(std::string(name) + "[" + std::to_string(N) +
+                             "][" + std::to_string(i) + "]");
+            return;
+        }
+    }
+}
+
+template <size_t N> void check_half(std::vector<std::string> &failed) {
+    using Half = dr::Array<half, N>;
+    using Float = dr::Array<float, N>;
+
+    half a_s[N], b_s[N], c_s[N];
+    for (size_t i = 0; i < N; ++i) {
+        a_s[i] = half(.375f * ((float) i - 3.3f) * (float) (i % 3 + 1));
+        b_s[i] = half(1.25f + .5f * (float) i);
+        c_s[i] = half(-2.f + .75f * (float) (i % 5));
+    }
+
+    Half a = dr::load<Half>(a_s), b = dr::load<Half>(b_s),
+         c = dr::load<Half>(c_s);
+
+    auto fa = [&](size_t i) { return (float) a_s[i]; };
+    auto fb = [&](size_t i) { return (float) b_s[i]; };
+    auto fc = [&](size_t i) { return (float) c_s[i]; };
+
+    // Loading and storing
+    half out[N];
+    dr::store(out, a);
+    for (size_t i = 0; i < N; ++i) {
+        if (memcmp(&out[i], &a_s[i], sizeof(half)) != 0) {
+            failed.push_back("store[" + std::to_string(N) + "]");
+            break;
+        }
+    }
+
+    // Vertical operations
+    check_op<N>(failed, "add", a + b, [&](size_t i) { return fa(i) + fb(i); });
+    check_op<N>(failed, "sub", a - b, [&](size_t i) { return fa(i) - fb(i); });
+    check_op<N>(failed, "mul", a * b, [&](size_t i) { return fa(i) * fb(i); });
+    check_op<N>(failed, "div", a / b, [&](size_t i) { return fa(i) / fb(i); });
+    check_op<N>(failed, "minimum", dr::minimum(a, c),
+                [&](size_t i) { return std::min(fa(i), fc(i)); });
+    check_op<N>(failed, "maximum", dr::maximum(a, c),
+                [&](size_t i) { return std::max(fa(i), fc(i)); });
+    check_op<N>(failed, "neg", -a, [&](size_t i) { return -fa(i); });
+    check_op<N>(failed, "abs", dr::abs(a),
+                [&](size_t i) { return std::abs(fa(i)); });
+    check_op<N>(failed, "sqrt", dr::sqrt(b),
+                [&](size_t i) { return std::sqrt(fb(i)); });
+    check_op<N>(failed, "floor", dr::floor(a),
+                [&](size_t i) { return std::floor(fa(i)); });
+    check_op<N>(failed, "ceil", dr::ceil(a),
+                [&](size_t i) { return std::ceil(fa(i)); });
+    check_op<N>(failed, "trunc", dr::trunc(a),
+                [&](size_t i) { return std::trunc(fa(i)); });
+    check_op<N>(failed, "round", dr::round(a),
+                [&](size_t i) { return std::nearbyint(fa(i)); });
+
+    // Native FP16 arithmetic may round differently than the single precision
+    // reference in a few cases, permit an error of one ULP
+    const float ulp = 1.f / 1024.f;
+    check_op<N>(failed, "fmadd", dr::fmadd(a, b, c),
+                [&](size_t i) { return std::fma(fa(i), fb(i), fc(i)); }, ulp);
+    check_op<N>(failed, "rcp", dr::rcp(b),
+                [&](size_t i) { return 1.f / fb(i); }, ulp);
+    check_op<N>(failed, "rsqrt", dr::rsqrt(b),
+                [&](size_t i) { return 1.f / std::sqrt(fb(i)); }, ulp);
+
+    // Comparisons, masks, and blending
+    auto lt = a < c;
+    check_mask<N>(failed, "lt", lt, [&](size_t i) { return fa(i) < fc(i); });
+    check_mask<N>(failed, "ge", a >= c, [&](size_t i) { return fa(i) >= fc(i); });
+    check_mask<N>(failed, "eq", dr::eq(a, a), [](size_t) { return true; });
+    check_mask<N>(failed, "neq", dr::neq(a, c),
+                  [&](size_t i) { return fa(i) != fc(i); });
+    check_mask<N>(failed, "not", !lt, [&](size_t i) { return !(fa(i) < fc(i)); });
+    check_op<N>(failed, "select", dr::select(lt, a, c),
+                [&](size_t i) { return fa(i) < fc(i) ? fa(i) : fc(i); });
+
+    size_t count = 0;
+    for (size_t i = 0; i < N; ++i)
+        count += fa(i) < fc(i);
+    if ((size_t) dr::count(lt) != count)
+        failed.push_back("count[" + std::to_string(N) + "]");
+
+    // Masks of single precision packets convert to half precision masks
+    Float af = Float(a), cf = Float(c);
+    check_mask<N>(failed, "mask_and", lt & dr::mask_t<Half>(af > -1.f),
+                  [&](size_t i) { return fa(i) < fc(i) && fa(i) > -1.f; });
+    check_mask<N>(failed, "mask_set", dr::mask_t<Half>(af < cf),
+                  [&](size_t i) { return fa(i) < fc(i); });
+
+    // Conversions
+    for (size_t i = 0; i < N; ++i) {
+        if (af.entry(i) != fa(i)) {
+            failed.push_back("to_float[" + std::to_string(N) + "]");
+            break;
+        }
+    }
+    check_op<N>(failed, "from_float", Half(af * 3.f),
+                [&](size_t i) { return fa(i) * 3.f; });
+
+    // Horizontal reductions are accumulated in single precision
+    float sum = 0.f, mn = fa(0), mx = fa(0);
+    for (size_t i = 0; i < N; ++i) {
+        sum += fa(i);
+        mn = std::min(mn, fa(i));
+        mx = std::max(mx, fa(i));
+    }
+    if (std::abs((float) dr::sum(a) - (float) half(sum)) > 4 * ulp * std::abs(sum))
+        failed.push_back("sum[" + std::to_string(N) + "]");
+    if ((float) dr::min(a) != mn)
+        failed.push_back("min[" + std::to_string(N) + "]");
+    if ((float) dr::max(a) != mx)
+        failed.push_back("max[" + std::to_string(N) + "]");
+}
+
+NB_MODULE(half_ext, m) {
+    // Tests: half precision packets (Array<half, N>) against the scalar path
+    m.def("check_half", [](size_t size) {
+        std::vector<std::string> failed;
+        switch (size) {
+            case 4:  check_half<4>(failed);  break;
+            case 8:  check_half<8>(failed);  break;
+            case 16: check_half<16>(failed); break;
+            default: throw std::runtime_error("check_half(): unsupported size!");
+        }
+        return failed;
+    });
+
+    // Is Array<half, N> implemented using a native packet type?
+    m.def("has_half_packet", [](size_t size) {
+        switch (size) {
+            case 8:  return dr::detail::vectorize_half<half, 8>::self;
+            case 16: return dr::detail::vectorize_half<half, 16>::self;
+            default: return false;
+        }
+    });
+}
@@ -0,0 +1,197 @@
+#include <nanobind/nanobind.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+#include <drjit/packet.h>
+#include <drjit/matrix.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace nb = nanobind;
+namespace dr = drjit;
+
+/// Compare compress_store() and expand_load() of Array<T, N> against the
+/// scalar loop for every mask with N bits
+template <typename T, size_t N>
+void check_compress(std::vector<std::string> &failed, const char *name) {
+    using Array = dr::Array<T, N>;
+    using Mask = dr::mask_t<Array>;
+
+    T value_s[N], sel_s[N];
+    for (size_t i = 0; i < N; ++i)
+        value_s[i] = T(3 * i + 1);
+    Array value = dr::load<Array>(value_s);
+
+    auto fail = [&](const char *op, uint32_t bits) {
+        failed.push_back(std::string(op) + "<" + name + ", " +
+                         std::to_string(N) + ">(mask=" + std::to_string(bits) +
+                         ")");
+    };
+
+    for (uint32_t bits = 0; bits < (1u << N); ++bits) {
+        for (size_t i = 0; i < N; ++i)
+            sel_s[i] = T((bits >> i) & 1);
+        Mask mask = dr::neq(dr::load<Array>(sel_s), T(0));
+
+        // Reference: the scalar loop
+        T ref[N];
+        size_t ref_count = 0;
+        for (size_t i = 0; i < N; ++i) {
+            if ((bits >> i) & 1)
+                ref[ref_count++] = value_s[i];
+        }
+
+        // Memory past the last stored entry must remain untouched
+        T out[N + 1];
+        for (size_t i = 0; i <= N; ++i)
+            out[i] = T(-1);
+
+        size_t count = dr::compress_store(out, value, mask);
+        if (count != ref_count ||
+            memcmp(out, ref, ref_count * sizeof(T)) != 0) {
+            fail("compress_store", bits);
+            return;
+        }
+
+        for (size_t i = count; i <= N; ++i) {
+            if (out[i] != T(-1)) {
+                fail("compress_store (overwrite)", bits);
+                return;
+            }
+        }
+
+        // Only the first 'count' entries of the input are active
+        Array expanded = dr::expand_load<Array>(ref, mask);
+        for (size_t i = 0; i < N; ++i) {
+            T expected = ((bits >> i) & 1) ? value_s[i] : T(0);
+            if (expanded.entry(i) != expected) {
+                fail("expand_load", bits);
+                return;
+            }
+        }
+    }
+}
+
+template <typename T>
+void check_compress_all(std::vector<std::string> &failed, const char *name,
+                        size_t size) {
+    switch (size) {
+        case 4:  check_compress<T, 4>(failed, name);  break;
+        case 8:  check_compress<T, 8>(failed, name);  break;
+        case 16: check_compress<T, 16>(failed, name); break;
+        default: throw std::runtime_error("check_compress(): unsupported size!");
+    }
+}
+
+/// Compare load_aos()/store_aos() of 'N' packets of type Array<T, W> against
+/// the scalar fallback
+template <typename T, size_t W, size_t N>
+void check_aos(std::vector<std::string> &failed, const char *name) {
+    using Packet = dr::Array<T, W>;
+    using Nested = dr::Array<Packet, N>;
+
+    auto fail = [&](const char *op) {
+        failed.push_back(std::string(op) + "<" + name + ", " +
+                         std::to_string(W) + ", " + std::to_string(N) + ">");
+    };
+
+    T in[W * N];
+    for (size_t i = 0; i < W * N; ++i)
+        in[i] = T(i) * T(1.5) - T(7);
+
+    // Record 'i' of the input holds field 'j' of lane 'i'
+    Nested value = dr::load_aos<Nested>(in);
+    for (size_t i = 0; i < W; ++i) {
+        for (size_t j = 0; j < N; ++j) {
+            if (value.entry(j).entry(i) != in[i * N + j]) {
+                fail("load_aos");
+                return;
+            }
+        }
+    }
+
+    // Round trip, memory past the last record must remain untouched
+    T out[W * N + 1];
+    for (size_t i = 0; i <= W * N; ++i)
+        out[i] = T(-1);
+
+    dr::store_aos(out, value);
+    if (memcmp(out, in, sizeof(in)) != 0 || out[W * N] != T(-1))
+        fail("store_aos");
+}
+
+template <typename T, size_t W>
+void check_aos_all(std::vector<std::string> &failed, const char *name) {
+    check_aos<T, W, 2>(failed, name);
+    check_aos<T, W, 3>(failed, name);
+    check_aos<T, W, 4>(failed, name);
+}
+
+/// Compare transpose() of an N x N matrix against the scalar loop
+template <typename T, size_t N>
+void check_transpose(std::vector<std::string> &failed, const char *name) {
+    using Row = dr::Array<T, N>;
+    using Array = dr::Array<Row, N>;
+
+    T rows[N][N];
+    Array value;
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t j = 0; j < N; ++j)
+            rows[i][j] = T(i * N + j);
+        value.entry(i) = dr::load<Row>(rows[i]);
+    }
+
+    Array result = dr::transpose(value);
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t j = 0; j < N; ++j) {
+            if (result.entry(i).entry(j) != rows[j][i]) {
+                failed.push_back(std::string("transpose<") + name + ", " +
+                                 std::to_string(N) + ">");
+                return;
+            }
+        }
+    }
+}
+
+template <typename T>
+void check_layout_all(std::vector<std::string> &failed, const char *name) {
+    check_aos_all<T, 2>(failed, name);
+    check_aos_all<T, 4>(failed, name);
+    check_aos_all<T, 8>(failed, name);
+    check_aos_all<T, 16>(failed, name);
+
+    check_transpose<T, 3>(failed, name);
+    check_transpose<T, 4>(failed, name);
+    check_transpose<T, 8>(failed, name);
+}
+
+NB_MODULE(packet_ext, m) {
+    // Tests: compress_store()/expand_load() of packets against the scalar loop
+    m.def("check_compress", [](const std::string &type, size_t size) {
+        std::vector<std::string> failed;
+        if (type == "float32")
+            check_compress_all<float>(failed, "float", size);
+        else if (type == "float64")
+            check_compress_all<double>(failed, "double", size);
+        else if (type == "int32")
+            check_compress_all<int32_t>(failed, "int32_t", size);
+        else if (type == "int64")
+            check_compress_all<int64_t>(failed, "int64_t", size);
+        else
+            throw std::runtime_error("check_compress(): unsupported type!");
+        return failed;
+    });
+
+    // Tests: load_aos()/store_aos() and transpose() against the scalar fallback
+    m.def("check_layout", [](const std::string &type) {
+        std::vector<std::string> failed;
+        if (type == "float32")
+            check_layout_all<float>(failed, "float");
+        else if (type == "float64")
+            check_layout_all<double>(failed, "double");
+        else
+            throw std::runtime_error("check_layout(): unsupported type!");
+        return failed;
+    });
+}
@@ -2027,3 +2027,209 @@ def test129_packet_scatter_add_bwd(t, enabled):
         dr.backward_to(x, y)
         assert dr.all(x.grad == [0,1,2,3,4,5,6,7])
         assert dr.all(dr.all(y.grad == [4,5,6,7]))
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test130_multithreaded_graphs(t):
+    # Several threads concurrently build and traverse AD graphs that share
+    # the operand 'c'. All values are small integers, hence the gradients
+    # must be exact regardless of how the threads interleave.
+    import threading
+
+    errors = []
+    n_threads, n_iter = 4, 20
+    c = dr.full(t, 3, 16)
+    dr.enable_grad(c)
+
+    def worker(seed):
+        try:
+            for i in range(n_iter):
+                x = dr.arange(t, 16) + seed
+                dr.enable_grad(x)
+                y = x * c
+                for j in range(10):
+                    y = y + x * (j + 1)
+                zs = [t(y) for k in range(10)] # exercise reference counting
+                z = zs[-1] * zs[0]
+                del zs
+                dr.backward_from(z)
+
+                # y = 58*x, z = y^2, dz/dx = 2*y*58
+                g = dr.grad(x)
+                if not dr.all(g == 2 * 58 * 58 * dr.detach(x)):
+                    raise RuntimeError(f"incorrect gradient: {g}")
+        except Exception as e:
+            errors.append(e)
+
+    threads = [threading.Thread(target=worker, args=(k,)) for k in range(n_threads)]
+    for th in threads:
+        th.start()
+    for th in threads:
+        th.join()
+
+    assert len(errors) == 0, errors
+
+    # dz/dc = 2*y*x = 116*x^2, accumulated over all threads and iterations
+    i = dr.arange(t, 16)
+    ref = dr.zeros(t, 16)
+    for k in range(n_threads):
+        ref += n_iter * 116 * (i + k) * (i + k)
+    assert dr.all(dr.grad(c) == ref)
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test131_parallel_traversal(t):
+    # Wide graph with many independent parameters; the parallel traversal
+    # mode should produce exactly the same gradients as the sequential one
+    def run(flags):
+        params = [dr.arange(t, 8) + i for i in range(100)]
+        dr.enable_grad(params)
+        y = 0
+        for i, p in enumerate(params):
+            y += dr.sin(p) * (i + 1) + p * params[(i * 7) % len(params)]
+        dr.backward_from(dr.sum(y), flags=flags)
+        return [dr.grad(p) for p in params]
+
+    g0 = run(dr.ADFlag.Default)
+    g1 = run(dr.ADFlag.Default | dr.ADFlag.ParallelTraversal)
+
+    for a, b in zip(g0, g1):
+        assert dr.all(a == b)
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test132_checkpoint(t):
+    # Gradients propagated through a checkpointed function should match
+    # those of the original computation in both AD modes
+    def f(x, y, scale=1):
+        for i in range(5):
+            x = dr.sin(x) * y + x
+        return x * scale
+
+    def run(checkpoint, mode):
+        x, y = dr.arange(t, 10), t(2)
+        dr.enable_grad(x, y)
+        if checkpoint:
+            z = dr.checkpoint(f, x, y, scale=3)
+        else:
+            z = f(x, y, scale=3)
+
+        assert dr.grad_enabled(z)
+        if mode == dr.ADMode.Backward:
+            dr.backward_from(z)
+            return dr.grad(x), dr.grad(y)
+        else:
+            dr.forward_from(x)
+            return (dr.grad(z),)
+
+    for mode in (dr.ADMode.Backward, dr.ADMode.Forward):
+        for a, b in zip(run(False, mode), run(True, mode)):
+            assert dr.allclose(a, b)
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test133_memory_budget(t):
+    # A tiny budget forces evaluation of gradients during the traversal
+    # without changing the result
+    def run(budget):
+        x = dr.linspace(t, 0, 1, 100)
+        dr.enable_grad(x)
+        y = x
+        for i in range(20):
+            y = dr.sin(y) * x + y
+        dr.eval(x, y)
+        dr.kernel_history_clear()
+
+        with dr.scoped_set_flag(dr.JitFlag.KernelHistory):
+            dr.set_grad_memory_budget(budget)
+            try:
+                assert dr.grad_memory_budget() == budget
+                dr.backward_from(y)
+            finally:
+                dr.set_grad_memory_budget(0)
+
+            # Count the kernels launched by the traversal itself
+            kernels = len(dr.kernel_history((dr.KernelType.JIT,)))
+
+        return dr.grad(x), kernels
+
+    g0, k0 = run(0)
+    g1, k1 = run(1024)
+    assert dr.grad_memory_budget() == 0
+
+    # Without a budget, gradients remain unevaluated until they are used
+    assert k0 == 0
+    assert k1 > 0
+    assert dr.allclose(g0, g1)
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test134_compact_graph(t):
+    # Collapsing elementwise chains should not change the gradients
+    def run(compact):
+        a, b, c, d = dr.linspace(t, 0, 1, 10), t(2), t(3), dr.arange(t, 10)
+        dr.enable_grad(a, b, c, d)
+        y = dr.exp(a * b + c) * d
+        y = dr.sin(y) * 2 + 1
+        if compact:
+            assert dr.compact_grad_graph() > 0
+        dr.backward_from(y)
+        return dr.grad(a), dr.grad(b), dr.grad(c), dr.grad(d)
+
+    for g0, g1 in zip(run(False), run(True)):
+        assert dr.allclose(g0, g1)
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test135_jacobian(t):
+    # y_i = p0 * i + p1 * i^2 + p2 * sin(i)
+    i = dr.arange(t, 8)
+    p = t(1, 2, 3)
+
+    def f(p):
+        p0, p1, p2 = dr.gather(t, p, 0), dr.gather(t, p, 1), dr.gather(t, p, 2)
+        return p0 * i + p1 * i * i + p2 * dr.sin(i)
+
+    j = dr.jacobian(f, p)
+    assert len(j) == 3
+    assert dr.allclose(j[0], i)
+    assert dr.allclose(j[1], i * i)
+    assert dr.allclose(j[2], dr.sin(i))
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test136_compact_graph_zero_weights(t):
+    # Collapsing a chain with the edge weights 0 and inf should preserve the
+    # masking of zero-valued gradients along the original chain
+    def run(w1, w2, mode, compact):
+        x = dr.arange(t, 10)
+        dr.enable_grad(x)
+        y = (x * dr.opaque(t, w1, 10)) * dr.opaque(t, w2, 10)
+        if compact:
+            assert dr.compact_grad_graph() > 0
+        if mode == dr.ADMode.Forward:
+            dr.forward_from(x)
+            return dr.grad(y)
+        else:
+            dr.backward_from(y)
+            return dr.grad(x)
+
+    for mode, w1, w2 in ((dr.ADMode.Forward, 0, dr.inf),
+                         (dr.ADMode.Backward, dr.inf, 0)):
+        g0 = run(w1, w2, mode, False)
+        g1 = run(w1, w2, mode, True)
+        assert dr.all(g0 == 0) and dr.all(g1 == 0)
+
+
+@pytest.test_arrays('is_diff,float32,shape=(*)')
+def test137_compact_graph_chain(t):
+    # A chain of elementwise multiplications collapses into a single edge
+    x = dr.arange(t, 10)
+    dr.enable_grad(x)
+    y = x
+    for i in range(10):
+        y = y * dr.opaque(t, i + 1, 10)
+
+    assert dr.compact_grad_graph() == 9
+    dr.backward_from(y)
+    assert dr.all(dr.grad(x) == 3628800)
@@ -55,3 +55,34 @@ def test02_struct_to_string():
   has_ray_differentials=1
 ]"""
     )
+
+
+@pytest.test_arrays("float32,is_diff,shape=(*),jit")
+def test03_checkpoint(t):
+    # The C++ drjit::checkpoint() should produce the same primal values and
+    # derivatives as the computation without checkpointing
+    pkg = get_pkg(t)
+
+    def f(a, b):
+        return dr.sin(a) * b + a * a
+
+    for mode in ("forward", "backward"):
+        x, y = t(1, 2, 3), t(4, 5, 6)
+        x2, y2 = t(x), t(y)
+        dr.enable_grad(x, y, x2, y2)
+
+        z = pkg.checkpoint(x, y)
+        z2 = f(x2, y2)
+        assert dr.allclose(z, z2)
+
+        if mode == "forward":
+            dr.set_grad(x, 1)
+            dr.set_grad(y, 2)
+            dr.set_grad(x2, 1)
+            dr.set_grad(y2, 2)
+            assert dr.allclose(dr.forward_to(z), dr.forward_to(z2))
+        else:
+            dr.backward_from(z)
+            dr.backward_from(z2)
+            assert dr.allclose(dr.grad(x), dr.grad(x2))
+            assert dr.allclose(dr.grad(y), dr.grad(y2))
@@ -0,0 +1,16 @@
+import drjit as dr
+import pytest
+
+
+def get_pkg():
+    with dr.detail.scoped_rtld_deepbind():
+        return pytest.importorskip("half_ext")
+
+
+@pytest.mark.parametrize("size", [4, 8, 16])
+def test01_half_packet(size):
+    # Compare Array<half, N> against the scalar 'half' path. When the
+    # extension was compiled with F16C/AVX512/NEON, this covers the native
+    # packet implementation, otherwise the generic fallback.
+    m = get_pkg()
+    assert m.check_half(size) == []
@@ -584,3 +584,81 @@ def test17_mutate_other_containers(t, tt, mutate, mode):
     assert dr.all(x == (10 + (mutate and tt != 'nested'), 20))
     assert dr.all(y == (30, 40))
 
+
+@pytest.test_arrays('float32,is_diff,shape=(*)')
+def test18_compact(t):
+    # Evaluated conditionals that run sparse branches on a compacted subset
+    # of the entries should produce the same results and derivatives
+    x = dr.arange(t, 16)
+    y = t(3)
+    dr.enable_grad(x, y)
+    cond = dr.mask_t(t)(x < 2)
+
+    threshold_prev = dr.cond_compact_threshold()
+    try:
+        dr.set_cond_compact_threshold(8)
+        x2, y2 = dr.if_stmt(
+            args = (x, y),
+            cond = cond,
+            true_fn = lambda x, y: (x * x * y, y),
+            false_fn = lambda x, y: (x + 1, y),
+            mode='evaluated'
+        )
+    finally:
+        dr.set_cond_compact_threshold(threshold_prev)
+
+    assert y2 is y
+    assert dr.all(x2 == dr.select(cond, x * x * 3, x + 1))
+
+    dr.backward(x2)
+    assert dr.all(dr.grad(x) == dr.select(cond, 2 * x * 3, 1))
+    assert dr.all(dr.grad(y) == 1)
+
+    # Conditionals that are captured symbolically should still check the
+    # size of their state variables while compaction is enabled
+    try:
+        dr.set_cond_compact_threshold(8)
+        with dr.scoped_set_flag(dr.JitFlag.SymbolicConditionals, True):
+            with pytest.raises(RuntimeError, match="the size of state variable 'x' of type"):
+                dr.if_stmt(
+                    args = (x,),
+                    cond = cond,
+                    true_fn = lambda _: (t(1, 2),),
+                    false_fn = lambda _: (t(1, 2, 3),),
+                    rv_labels=('x',)
+                )
+    finally:
+        dr.set_cond_compact_threshold(threshold_prev)
+
+
+@pytest.test_arrays('float32,is_diff,shape=(*)')
+def test19_compact_non_argument(t):
+    # Compacted branches can only combine their arguments with variables of
+    # size 1. Other variables must be passed as arguments.
+    x = dr.arange(t, 16)
+    z = dr.arange(t, 16) + 1
+    cond = dr.mask_t(t)(x < 2)
+
+    threshold_prev = dr.cond_compact_threshold()
+    try:
+        dr.set_cond_compact_threshold(8)
+        with pytest.raises(RuntimeError):
+            dr.if_stmt(
+                args = (x,),
+                cond = cond,
+                true_fn = lambda x: (x * z,),
+                false_fn = lambda x: (x,),
+                mode='evaluated'
+            )
+
+        x2, _ = dr.if_stmt(
+            args = (x, z),
+            cond = cond,
+            true_fn = lambda x, z: (x * z, z),
+            false_fn = lambda x, z: (x, z),
+            mode='evaluated'
+        )
+    finally:
+        dr.set_cond_compact_threshold(threshold_prev)
+
+    assert dr.all(x2 == dr.select(cond, x * z, x))
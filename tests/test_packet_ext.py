@@ -0,0 +1,26 @@
+import drjit as dr
+import pytest
+
+
+def get_pkg():
+    with dr.detail.scoped_rtld_deepbind():
+        return pytest.importorskip("packet_ext")
+
+
+@pytest.mark.parametrize("size", [4, 8, 16])
+@pytest.mark.parametrize("type", ["float32", "float64", "int32", "int64"])
+def test01_compress_expand(type, size):
+    # Compare compress_store()/expand_load() against the scalar loop for all
+    # masks. When the extension was compiled with SSE4.2/AVX/AVX512/NEON,
+    # this covers the native packet implementations. Arrays with 16 entries
+    # are additionally split into smaller packets on most targets.
+    m = get_pkg()
+    assert m.check_compress(type, size) == []
+
+
+@pytest.mark.parametrize("type", ["float32", "float64"])
+def test02_aos_transpose(type):
+    # Round-trip load_aos()/store_aos() with 2, 3, and 4 fields and compare
+    # transpose() of 3x3, 4x4, and 8x8 matrices against the scalar fallback
+    m = get_pkg()
+    assert m.check_layout(type) == []
@@ -647,3 +647,136 @@ def test16_switch_loop_in_target(t, symbolic):
 
         result = dr.switch(index, c, x)
         assert dr.allclose(result, [30, 33, 30, 40, 50])
+
+
+@pytest.test_arrays('float32,shape=(*),jit,is_diff')
+def test18_switch_sort_by_callee(t):
+    # Sorting entries by callee should not change results or derivatives
+    UInt32 = dr.uint32_array_t(t)
+
+    c = [
+        lambda a: a * 2,
+        lambda a: a * a,
+        lambda a: a + 10
+    ]
+
+    idx = UInt32(2, 0, 1, 2, 1, 0, 0, 2)
+    a = t(1, 2, 3, 4, 5, 6, 7, 8)
+    dr.enable_grad(a)
+
+    sort_prev = dr.call_sort_by_callee()
+    try:
+        dr.set_call_sort_by_callee(True)
+        with dr.scoped_set_flag(dr.JitFlag.SymbolicCalls, True):
+            result = dr.switch(idx, c, a)
+    finally:
+        dr.set_call_sort_by_callee(sort_prev)
+
+    assert dr.allclose(result, [11, 4, 9, 14, 25, 12, 14, 18])
+
+    dr.backward(result)
+    assert dr.allclose(dr.grad(a), [1, 2, 6, 1, 10, 2, 2, 1])
+
+
+@pytest.test_arrays('float32,shape=(*),jit,is_diff')
+def test19_switch_batched(t):
+    # Evaluated calls with batched kernel launches should produce the same
+    # results and derivatives
+    UInt32 = dr.uint32_array_t(t)
+
+    c = [
+        lambda a: a * 2,
+        lambda a: a * a,
+        lambda a: a + 10
+    ]
+
+    idx = UInt32(2, 0, 1, 2, 1, 0, 0, 2)
+    a = t(1, 2, 3, 4, 5, 6, 7, 8)
+    dr.enable_grad(a)
+
+    batched_prev = dr.call_batched()
+    try:
+        dr.set_call_batched(True)
+        with dr.scoped_set_flag(dr.JitFlag.SymbolicCalls, False):
+            result = dr.switch(idx, c, a)
+    finally:
+        dr.set_call_batched(batched_prev)
+
+    assert dr.allclose(result, [11, 4, 9, 14, 25, 12, 14, 18])
+
+    dr.backward(result)
+    assert dr.allclose(dr.grad(a), [1, 2, 6, 1, 10, 2, 2, 1])
+
+
+@pytest.test_arrays('float32,shape=(*),jit,is_diff')
+@pytest.mark.parametrize("idx, value, grad", [
+    # The large bucket has the lowest/highest callable ID
+    ([0, 0, 0, 0, 1, 2, 3, 0], [2, 4, 6, 8, 25, 16, 6, 16], [2, 2, 2, 2, 10, 1, 1, 2]),
+    ([3, 3, 3, 3, 0, 1, 2, 3], [0, 1, 2, 3, 10, 36, 17, 7], [1, 1, 1, 1, 2, 12, 1, 1])
+])
+def test20_switch_small_buckets(t, idx, value, grad):
+    # Evaluated calls that dispatch small buckets symbolically should produce
+    # the same results and derivatives
+    UInt32 = dr.uint32_array_t(t)
+
+    c = [
+        lambda a: a * 2,
+        lambda a: a * a,
+        lambda a: a + 10,
+        lambda a: a - 1
+    ]
+
+    idx = UInt32(idx)
+    a = t(1, 2, 3, 4, 5, 6, 7, 8)
+    dr.enable_grad(a)
+
+    threshold_prev = dr.call_small_bucket_threshold()
+    try:
+        dr.set_call_small_bucket_threshold(2)
+        with dr.scoped_set_flag(dr.JitFlag.SymbolicCalls, False):
+            result = dr.switch(idx, c, a)
+    finally:
+        dr.set_call_small_bucket_threshold(threshold_prev)
+
+    assert dr.allclose(result, value)
+
+    dr.backward(result)
+    assert dr.allclose(dr.grad(a), grad)
+
+
+@pytest.test_arrays('float32,shape=(*),jit,is_diff')
+@pytest.mark.parametrize("symbolic", [True, False])
+def test21_switch_devirtualize(t, symbolic):
+    # Calls whose active entries all target the same callee are inlined
+    # and reported in the kernel history
+    UInt32 = dr.uint32_array_t(t)
+    Bool = dr.mask_t(t)
+
+    c = [
+        lambda a: a * 2,
+        lambda a: a * a,
+    ]
+
+    idx = UInt32(1, 1, 1, 0)
+    active = Bool(True, True, True, False)
+    dr.eval(idx, active)
+
+    a = t(1, 2, 3, 4)
+    dr.enable_grad(a)
+
+    devirtualize_prev = dr.call_devirtualize()
+    try:
+        dr.set_call_devirtualize(True)
+        dr.kernel_history_clear()
+        with dr.scoped_set_flag(dr.JitFlag.SymbolicCalls, symbolic):
+            with dr.scoped_set_flag(dr.JitFlag.KernelHistory, True):
+                result = dr.switch(idx, c, a, active=active)
+                history = dr.kernel_history((dr.KernelType.Other,))
+    finally:
+        dr.set_call_devirtualize(devirtualize_prev)
+
+    assert any('devirtualized' in h and h['instance'] == 2 for h in history)
+    assert dr.allclose(result, [1, 4, 9, 0])
+
+    dr.backward(result)
+    assert dr.allclose(dr.grad(a), [2, 4, 6, 0])
@@ -417,3 +417,136 @@ def test14_preserve_attached(t):
     v3 = t(v2)
     dr.forward_to(v3)
     assert dr.all(v3.grad == [10, 20, 30])
+
+
+@pytest.mark.parametrize('shapes', [
+    ((3, 5), (5, 2)),
+    ((9, 20), (20, 7)),
+    ((4,), (4, 3)),
+    ((3, 4), (4,)),
+    ((4,), (4,)),
+    ((2, 3, 4), (4, 5)),
+    ((2, 1, 6, 17), (3, 17, 8)),
+])
+@pytest.test_arrays('is_tensor, float32')
+def test15_matmul(t, shapes):
+    np = pytest.importorskip("numpy")
+    shape_a, shape_b = shapes
+    a_n = np.arange(np.prod(shape_a), dtype=np.float32).reshape(shape_a) % 7 - 3
+    b_n = np.arange(np.prod(shape_b), dtype=np.float32).reshape(shape_b) % 5 - 2
+
+    c = t(a_n) @ t(b_n)
+    c_n = a_n @ b_n
+    assert c.shape == c_n.shape
+    assert np.allclose(c.numpy(), c_n)
+
+    with pytest.raises(RuntimeError, match='drjit.matmul'):
+        dr.matmul(t(a_n), t(np.zeros((3, 3), dtype=np.float32)))
+
+
+@pytest.mark.parametrize('shapes', [
+    ((3, 5), (5, 2)),
+    ((20, 18), (18, 9)),
+    ((2, 3, 4), (4, 5)),
+])
+@pytest.test_arrays('is_tensor, float32, is_diff')
+def test16_matmul_ad(t, shapes):
+    np = pytest.importorskip("numpy")
+    shape_a, shape_b = shapes
+    a_n = np.arange(np.prod(shape_a), dtype=np.float32).reshape(shape_a) % 7 - 3
+    b_n = np.arange(np.prod(shape_b), dtype=np.float32).reshape(shape_b) % 5 - 2
+
+    a, b = t(a_n), t(b_n)
+    dr.enable_grad(a, b)
+    c = a @ b
+    g_n = np.ones(c.shape, dtype=np.float32)
+
+    # Reverse mode: grad_a = g @ b^T, grad_b = a^T @ g (summed over the batch)
+    dr.backward_from(c)
+    grad_b_n = np.swapaxes(a_n, -1, -2) @ g_n
+    grad_b_n = grad_b_n.reshape(-1, *shape_b).sum(axis=0)
+    assert np.allclose(a.grad.numpy(), g_n @ b_n.T)
+    assert np.allclose(b.grad.numpy(), grad_b_n)
+
+    # Forward mode
+    a, b = t(a_n), t(b_n)
+    dr.enable_grad(a, b)
+    dr.set_grad(a, 1)
+    c = a @ b
+    dr.forward_to(c)
+    assert np.allclose(c.grad.numpy(), np.ones(shape_a, dtype=np.float32) @ b_n)
+
+
+@pytest.mark.parametrize('stacked', [False, True])
+@pytest.test_arrays('is_tensor, float32, is_diff')
+def test17_mlp_eval(t, stacked):
+    np = pytest.importorskip("numpy")
+    Float = dr.array_t(t)
+    w_n = (np.arange(2 * 3 * 3, dtype=np.float32).reshape(2, 3, 3) % 5 - 2) * .25
+    b_n = np.array([[.5, -1, 0], [0, .25, 1]], dtype=np.float32)
+    x_n = np.array([[1, 2, 3, 4], [-1, 0, 1, 2], [.5, .5, -.5, -.5]], dtype=np.float32)
+
+    if stacked:
+        w, b = t(w_n), t(b_n)
+        dr.enable_grad(w, b)
+        w_last, b_last = w, b
+    else:
+        w, b = [t(w_n[0]), t(w_n[1])], [t(b_n[0]), t(b_n[1])]
+        dr.enable_grad(w, b)
+        w_last, b_last = w[1], b[1]
+
+    x = [Float(v) for v in x_n]
+    y = dr.mlp_eval(x, w, b, activation='relu')
+
+    h_n = np.maximum(w_n[0] @ x_n + b_n[0][:, None], 0)
+    y_n = w_n[1] @ h_n + b_n[1][:, None]
+    for i in range(3):
+        assert dr.allclose(y[i], y_n[i])
+
+    # The output layer is linear: dL/dW = sum over lanes of outer(1, h)
+    dr.backward_from(y[0] + y[1] + y[2])
+    grad_w = np.ones((3, 1), dtype=np.float32) * h_n.sum(axis=1)[None, :]
+    if stacked:
+        assert np.allclose(w_last.grad.numpy()[1], grad_w)
+        assert np.allclose(b_last.grad.numpy()[1], 4)
+    else:
+        assert np.allclose(w_last.grad.numpy(), grad_w)
+        assert np.allclose(b_last.grad.numpy(), 4)
+
+    with pytest.raises(RuntimeError, match='unsupported activation'):
+        dr.mlp_eval(x, w, b, activation='gelu')
+
+
+@pytest.test_arrays('is_tensor, float32, is_diff')
+def test18_mlp_eval_loop_ad(t):
+    # Reverse-mode derivative of an MLP evaluated within a symbolic loop,
+    # compared against the derivative of the same computation without loop
+    np = pytest.importorskip("numpy")
+    Float = dr.array_t(t)
+    UInt32 = dr.uint32_array_t(Float)
+    w_n = (np.arange(2 * 3 * 3, dtype=np.float32).reshape(2, 3, 3) % 5 - 2) * .25
+    b_n = np.array([[.5, -1, 0], [0, .25, 1]], dtype=np.float32)
+    x = [Float(1, 2, 3, 4), Float(-1, 0, 1, 2), Float(.5, .5, -.5, -.5)]
+
+    def f(w, b):
+        y = dr.mlp_eval(x, w, b, activation='tanh')
+        return y[0] + y[1] + y[2]
+
+    w, b = t(w_n), t(b_n)
+    dr.enable_grad(w, b)
+    _, acc = dr.while_loop(
+        state=(dr.zeros(UInt32, 4), dr.zeros(Float, 4)),
+        cond=lambda i, acc: i < 3,
+        body=lambda i, acc: (i + 1, acc + f(w, b)),
+        mode='symbolic'
+    )
+    dr.backward_from(acc)
+
+    w_ref, b_ref = t(w_n), t(b_n)
+    dr.enable_grad(w_ref, b_ref)
+    acc_ref = 3 * f(w_ref, b_ref)
+    dr.backward_from(acc_ref)
+
+    assert dr.allclose(acc, acc_ref)
+    assert np.allclose(w.grad.numpy(), w_ref.grad.numpy())
+    assert np.allclose(b.grad.numpy(), b_ref.grad.numpy())
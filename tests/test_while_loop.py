@@ -625,3 +625,151 @@ def test26_gather(t):
         i += 1
 
     assert dr.all(x == [6, 5])
+
+
+@pytest.mark.parametrize("threshold", [1, 0.9, 0.5])
+@pytest.test_arrays('uint32,is_jit,shape=(*)')
+def test27_compress_threshold(t, threshold):
+    # Adaptive loop state compression should not affect the result
+    state = dr.arange(t, 10000) + 1
+    it_count = dr.zeros(t, 10000)
+
+    def body(state, it_count):
+        state = dr.select(state & 1 == 0, state // 2, 3*state + 1)
+        return state, it_count + 1
+
+    threshold_prev = dr.loop_compress_threshold()
+    try:
+        dr.set_loop_compress_threshold(threshold)
+        dr.clear_loop_stats()
+        state, it_count = dr.while_loop(
+            state=(state, it_count),
+            cond=lambda state, it_count: state != 1,
+            body=body,
+            mode='evaluated',
+            compress=True,
+            label='collatz'
+        )
+    finally:
+        dr.set_loop_compress_threshold(threshold_prev)
+
+    assert dr.sum(it_count) == 849666
+
+    stats = dr.loop_stats('collatz')
+    assert dr.max(it_count) == stats['iterations']
+    assert stats['lanes'] >= stats['active_lanes'] == 849666
+    if threshold == 1:
+        assert stats['masked'] == 0
+    else:
+        assert stats['masked'] > 0
+
+
+@pytest.mark.parametrize("chunk", [0, 1, 16])
+@pytest.mark.parametrize("compress", [True, False])
+@pytest.test_arrays('uint32,is_jit,shape=(*)')
+@dr.syntax
+def test28_hybrid(t, chunk, compress):
+    # Hybrid loops should compute the same result as other loop modes
+    state = dr.arange(t, 10000) + 1
+    it_count = dr.zeros(t, 10000)
+
+    chunk_prev = dr.loop_hybrid_chunk_size()
+    try:
+        dr.set_loop_hybrid_chunk_size(chunk)
+        while dr.hint(state != 1, mode='hybrid', compress=compress):
+            state = dr.select(
+                state & 1 == 0,
+                state // 2,
+                3*state + 1
+            )
+            it_count += 1
+    finally:
+        dr.set_loop_hybrid_chunk_size(chunk_prev)
+
+    assert dr.sum(it_count) == 849666
+    assert dr.all(state == 1)
+
+
+@pytest.mark.parametrize('mode', ['symbolic', 'evaluated'])
+@pytest.test_arrays('float32,is_jit,shape=(*)')
+def test29_hoist(t, mode):
+    # Loop-invariant expressions can be hoisted in front of the loop
+    UInt32 = dr.uint32_array_t(t)
+
+    @dr.syntax(hoist=True)
+    def f(a, b, n):
+        i, y = UInt32(0), dr.zeros(t, 3)
+        while dr.hint(i < n, mode=mode):
+            y += dr.sqrt(a * b) + t(i)
+            i += 1
+        return y
+
+    assert '_loop_inv0' in f.__code__.co_cellvars
+    y = f(t(1, 2, 3), t(4, 8, 12), UInt32(1, 2, 3))
+    assert dr.allclose(y, [2, 9, 21])
+
+
+@pytest.mark.parametrize('mode', ['symbolic', 'evaluated'])
+@pytest.mark.parametrize('unroll', [2, 3])
+@pytest.test_arrays('uint32,is_jit,shape=(*)')
+@dr.syntax
+def test30_unroll(t, mode, unroll):
+    # Partially unrolled loops should compute the same result as other loops
+    state = dr.arange(t, 1000) + 1
+    it_count = dr.zeros(t, 1000)
+
+    while dr.hint(state != 1, mode=mode, unroll=unroll):
+        state = dr.select(
+            state & 1 == 0,
+            state // 2,
+            3*state + 1
+        )
+        it_count += 1
+
+    assert dr.sum(it_count) == 59542
+    assert dr.all(state == 1)
+
+
+@pytest.test_arrays('float32,is_diff,shape=(*)')
+@dr.syntax
+def test31_unroll_full(t):
+    # Fully unrolled loops turn into straight-line code
+    UInt32 = dr.uint32_array_t(t)
+    x = t(1, 2, 3)
+    dr.enable_grad(x)
+
+    i, y = UInt32(0), t(1)
+    while dr.hint(i < 4, unroll='full'):
+        y *= x
+        i += 1
+
+    assert dr.allclose(y, [1, 16, 81])
+    dr.backward_from(y)
+    assert dr.allclose(dr.grad(x), [4, 32, 108])
+
+    # The loop condition must be known while tracing
+    with pytest.raises(RuntimeError, match='literal constant'):
+        i = dr.opaque(UInt32, 0)
+        while dr.hint(i < 4, unroll='full'):
+            i += 1
+
+
+@pytest.mark.parametrize('mode', ['symbolic', 'evaluated'])
+@pytest.test_arrays('float32,is_jit,shape=(*)')
+def test32_hoist_conditional(t, mode):
+    # Expressions within conditionally executed code must not be hoisted,
+    # since this could raise exceptions when their operands are Python scalars
+    UInt32 = dr.uint32_array_t(t)
+
+    @dr.syntax(hoist=True)
+    def f(n, k):
+        i, y = UInt32(0), dr.zeros(t, 3)
+        while dr.hint(i < 3, mode=mode):
+            if k != 0:
+                y += n // k
+            y += (n // k) if k != 0 else 1
+            i += 1
+        return y
+
+    assert dr.all(f(6, 0) == 3)
+    assert dr.all(f(6, 2) == 18)
@@ -184,3 +184,84 @@ def test07_gather_in_loop_fwd_nested(t, mode, variant):
     dr.forward_to(y)
     assert dr.all(y.grad == 16)
 
+
+@pytest.mark.parametrize('budget', [0, 1, 3, 4])
+@pytest.test_arrays('float32,is_diff,shape=(*)')
+def test08_complex_loop_rev(t, budget):
+    # Reverse-mode derivative of a symbolic loop with an iteration bound,
+    # whose intermediate states are recomputed from checkpoints. Compare
+    # against the derivative of an evaluated loop.
+    UInt = dr.uint32_array_t(t)
+
+    def run(mode):
+        x = t(2, 3, 4, 5)
+        dr.enable_grad(x)
+        _, y, _ = dr.while_loop(
+            state=(x, t(1, 1, 1, 1), dr.zeros(UInt, 4)),
+            cond=lambda x, y, i: i < UInt(3, 5, 8, 13),
+            body=lambda x, y, i: (x, .5*(y + x/y), i + 1),
+            mode=mode,
+            max_iterations=20
+        )
+        dr.backward_from(y)
+        return y, x.grad
+
+    budget_prev = dr.loop_checkpoint_budget()
+    try:
+        dr.set_loop_checkpoint_budget(budget)
+        y, grad = run('symbolic')
+    finally:
+        dr.set_loop_checkpoint_budget(budget_prev)
+
+    y_ref, grad_ref = run('evaluated')
+    assert dr.allclose(y, y_ref)
+    assert dr.allclose(grad, grad_ref)
+
+
+@pytest.test_arrays('float32,is_diff,shape=(*)')
+def test09_complex_loop_rev_side_effects(t):
+    # Replaying a loop body with side effects during the reverse-mode
+    # derivative would run them twice. This should raise an error.
+    UInt = dr.uint32_array_t(t)
+    counter = dr.zeros(UInt, 1)
+
+    x = t(2, 3, 4, 5)
+    dr.enable_grad(x)
+
+    def body(x, y, i):
+        dr.scatter_add(counter, 1, UInt(0))
+        return x, .5*(y + x/y), i + 1
+
+    _, y, _ = dr.while_loop(
+        state=(x, t(1, 1, 1, 1), dr.zeros(UInt, 4)),
+        cond=lambda x, y, i: i < 5,
+        body=body,
+        mode='symbolic',
+        max_iterations=20
+    )
+
+    with pytest.raises(RuntimeError, match="side effects"):
+        dr.backward_from(y)
+
+    # The side effect only ran during the original loop
+    assert counter[0] == 20
+
+
+@pytest.test_arrays('float32,is_diff,shape=(*)')
+def test10_complex_loop_rev_bound(t):
+    # The reverse-mode derivative should stop replaying a loop as soon as it
+    # exceeds its iteration bound
+    UInt = dr.uint32_array_t(t)
+    x = t(2, 3, 4, 5)
+    dr.enable_grad(x)
+
+    _, y, _ = dr.while_loop(
+        state=(x, t(1, 1, 1, 1), dr.zeros(UInt, 4)),
+        cond=lambda x, y, i: i < 13,
+        body=lambda x, y, i: (x, .5*(y + x/y), i + 1),
+        mode='symbolic',
+        max_iterations=5
+    )
+
+    with pytest.raises(RuntimeError, match="exceeds the specified bound"):
+        dr.backward_from(y)